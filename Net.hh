@@ -23,11 +23,70 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cerrno>
+#include <condition_variable>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
 #include <functional>
+#include <future>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <ostream>
 #include <random>
+#include <span>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#define NET_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define NET_HAS_MMAP 0
+#endif
+
+#if __has_include(<sys/socket.h>) && __has_include(<sys/wait.h>)
+#define NET_HAS_PROCESS 1
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#else
+#define NET_HAS_PROCESS 0
+#endif
+
+#if !defined(NET_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && \
+	defined(__GNUC__)
+#define NET_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define NET_X86_SIMD 0
+#endif
 
 namespace net {
 // main type used for storing, input and output data
@@ -36,7 +95,127 @@ using store_type = float;
 // mutations will be in [-mutk, mutk]
 constexpr store_type mutk = 50.f;
 
+// 16 bit IEEE 754 floating point number (binary16)
+// it's used only for storing data, values are computed as float
+class half {
+   public:
+	// largest finite value
+	constexpr static float max = 65504.f;
+
+	constexpr half() = default;
+	// round @value@ to nearest (ties to even)
+	constexpr explicit half(float value) : bits(from_float(value)) {}
+
+	constexpr operator float() const { return to_float(bits); }
+
+	constexpr bool operator==(const half&) const = default;
+
+   private:
+	constexpr static std::uint16_t from_float(float value) {
+		const auto x = std::bit_cast<std::uint32_t>(value);
+		const auto sign = static_cast<std::uint16_t>((x >> 16) & 0x8000);
+		auto mant = x & 0x7fffff;
+		int exp = static_cast<int>((x >> 23) & 0xff);
+
+		// infinity and NaN
+		if (exp == 0xff)
+			return sign | 0x7c00 | (mant ? 0x200 : 0);
+
+		exp -= 127 - 15;
+		if (exp >= 0x1f)
+			return sign | 0x7c00;
+
+		// subnormal or zero
+		if (exp <= 0) {
+			if (exp < -10)
+				return sign;
+			mant |= 0x800000;
+			const auto shift = static_cast<unsigned>(14 - exp);
+			auto h = mant >> shift;
+			const auto rem = mant & ((1u << shift) - 1);
+			const auto tie = 1u << (shift - 1);
+			if (rem > tie || (rem == tie && (h & 1)))
+				++h;
+			return sign | static_cast<std::uint16_t>(h);
+		}
+
+		// carry of rounding goes to exponent (up to infinity)
+		auto h = (static_cast<std::uint32_t>(exp) << 10) | (mant >> 13);
+		const auto rem = mant & 0x1fff;
+		if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+			++h;
+		return sign | static_cast<std::uint16_t>(h);
+	}
+
+	constexpr static float to_float(std::uint16_t h) {
+		const auto sign = static_cast<std::uint32_t>(h & 0x8000) << 16;
+		const auto exp = (h >> 10) & 0x1f;
+		const auto mant = static_cast<std::uint32_t>(h & 0x3ff);
+
+		if (exp == 0) {
+			// subnormal is mant * 2^-24 (exact in float)
+			const auto value = static_cast<float>(mant) * 0x1p-24f;
+			return sign ? -value : value;
+		}
+		if (exp == 0x1f)
+			return std::bit_cast<float>(sign | 0x7f800000 | (mant << 13));
+		return std::bit_cast<float>(
+			sign | (static_cast<std::uint32_t>(exp + 127 - 15) << 23) |
+			(mant << 13));
+	}
+
+	std::uint16_t bits = 0;
+};
+
+// 16 bit brain floating point number (upper half of float)
+// it's used only for storing data, values are computed as float
+class bfloat16 {
+   public:
+	// largest finite value
+	constexpr static float max = 0x1.fep127f;
+
+	constexpr bfloat16() = default;
+	// round @value@ to nearest (ties to even)
+	constexpr explicit bfloat16(float value) : bits(from_float(value)) {}
+
+	constexpr operator float() const {
+		return std::bit_cast<float>(static_cast<std::uint32_t>(bits) << 16);
+	}
+
+	constexpr bool operator==(const bfloat16&) const = default;
+
+   private:
+	constexpr static std::uint16_t from_float(float value) {
+		const auto x = std::bit_cast<std::uint32_t>(value);
+		// keep NaN quiet, rounding could turn it into infinity
+		if ((x & 0x7fffffff) > 0x7f800000)
+			return static_cast<std::uint16_t>((x >> 16) | 0x40);
+		return static_cast<std::uint16_t>(
+			(x + 0x7fff + ((x >> 16) & 1)) >> 16);
+	}
+
+	std::uint16_t bits = 0;
+};
+
+// type used for computing values stored as T
+// half and bfloat16 are only stored, so they are computed as float
+template <typename T>
+struct compute_type {
+	using type = T;
+};
+template <>
+struct compute_type<half> {
+	using type = float;
+};
+template <>
+struct compute_type<bfloat16> {
+	using type = float;
+};
+template <typename T>
+using compute_type_t = typename compute_type<T>::type;
+
 // container for input and output data
+// elements are stored inline so creating and copying array never allocates
 template <typename T, std::size_t S>
 class array {
    public:
@@ -54,7 +233,7 @@ class array {
 	using reverse_iterator = std::reverse_iterator<iterator>;
 	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-	constexpr array() : _data(new value_type[S]) {}
+	constexpr array() = default;
 	constexpr array(const std::initializer_list<value_type>& list) : array() {
 		std::memcpy(data(), list.begin(), list.size() * sizeof(value_type));
 	}
@@ -68,11 +247,12 @@ class array {
 			++oit;
 		}
 	}
-	constexpr array(const array& other) : array() { *this = other; }
+	// storage is inline, so copying and moving are trivial
+	constexpr array(const array&) = default;
+	constexpr array(array&&) = default;
 	constexpr array(const std::array<value_type, S>& arr) : array() {
 		*this = arr;
 	}
-	constexpr ~array() { release(); }
 
 	constexpr reference operator[](size_type index) {
 		return *(data() + index);
@@ -96,20 +276,16 @@ class array {
 	constexpr size_type size() const noexcept { return S; }
 	constexpr size_type max_size() const noexcept { return size(); }
 
-	constexpr void operator=(const array& other) {
-		std::memcpy(data(), other.data(), size() * sizeof(value_type));
-	}
+	constexpr array& operator=(const array&) = default;
+	constexpr array& operator=(array&&) = default;
 
-	constexpr void operator=(const std::array<value_type, S>& other) {
+	constexpr array& operator=(const std::array<value_type, S>& other) {
 		std::memcpy(data(), other.data(), size() * sizeof(value_type));
+		return *this;
 	}
 
-	constexpr void release() noexcept {
-		if (_data != nullptr) {
-			delete[] _data;
-			_data = nullptr;
-		}
-	}
+	// nothing to release: storage is inline (kept for compatibility)
+	constexpr void release() noexcept {}
 
 	constexpr reference front() { return operator[](0); }
 	constexpr const_reference front() const { return operator[](0); }
@@ -148,7 +324,7 @@ class array {
 		return std::make_reverse_iterator(begin());
 	}
 
-	constexpr void fill(const T& val) { std::memset(data(), val, size()); }
+	constexpr void fill(const T& val) { std::fill(begin(), end(), val); }
 
 	constexpr void swap(array& other) noexcept(std::is_nothrow_swappable_v<T>) {
 		auto oit = other.begin();
@@ -171,10 +347,105 @@ class array {
 	}
 
    private:
-	T* _data;
+	T _data[S]{};
+};
+
+// xoshiro256++ random number generator (satisfies UniformRandomBitGenerator)
+// much faster than std::random_device and reproducible from seed
+class xoshiro256pp {
+   public:
+	using result_type = std::uint64_t;
+
+	// construct generator seeded by @value@
+	constexpr explicit xoshiro256pp(std::uint64_t value = 0) { seed(value); }
+
+	// reset state from @value@ (state is expanded by splitmix64)
+	constexpr void seed(std::uint64_t value) {
+		for (auto& st : state) {
+			value += 0x9e3779b97f4a7c15;
+			auto z = value;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+			st = z ^ (z >> 31);
+		}
+	}
+
+	constexpr static result_type min() { return 0; }
+	constexpr static result_type max() { return ~result_type{0}; }
+
+	constexpr result_type operator()() {
+		const auto o = rotl(state[0] + state[3], 23) + state[0];
+		const auto t = state[1] << 17;
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotl(state[3], 45);
+
+		return o;
+	}
+
+	// advance state by 2^128 calls, used for splitting non-overlapping
+	// streams from one seed
+	constexpr void jump() {
+		constexpr std::uint64_t jumps[] = {0x180ec6d33cfd0aba,
+										   0xd5a61266f0c9392c,
+										   0xa9582618e03fc9aa,
+										   0x39abdc4529b1661c};
+		std::uint64_t s[4] = {};
+		for (auto j : jumps) {
+			for (int b = 0; b < 64; ++b) {
+				if (j & (std::uint64_t{1} << b)) {
+					for (int i = 0; i < 4; ++i)
+						s[i] ^= state[i];
+				}
+				operator()();
+			}
+		}
+		for (int i = 0; i < 4; ++i)
+			state[i] = s[i];
+	}
+
+	constexpr bool operator==(const xoshiro256pp&) const = default;
+
+   private:
+	constexpr static std::uint64_t rotl(std::uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+
+	std::uint64_t state[4] = {};
+};
+
+// generator used by default
+using random_engine = xoshiro256pp;
+
+// return seed from std::random_device
+inline std::uint64_t random_seed() {
+	std::random_device rd;
+	return (std::uint64_t{rd()} << 32) ^ rd();
+}
+
+// generator of current thread seeded by random_seed()
+// every thread has its own stream, so it can be used without locking
+inline random_engine& thread_random() {
+	thread_local random_engine engine{random_seed()};
+	return engine;
+}
+
+// ways of combining data of two parents into child
+enum class crossover_type {
+	// [0, l) and [r, end) from first parent, [l, r) from second one
+	two_point,
+	// every value from random parent
+	uniform,
+	// segments between random points taken from parents in turn
+	multi_point,
+	// child = a + t * (b - a) for random t in [0, 1)
+	blend,
 };
 
-namespace {
 // absolute value
 constexpr auto abs(auto x) {
 	return x > 0 ? x : -x;
@@ -185,16 +456,225 @@ constexpr auto sigmoid(auto x) {
 	return x / (1 + abs(x));
 }
 
+// neurons are computed without contracting multiplication and addition into
+// FMA, so results don't depend on instruction set and compiler flags
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC push_options
+#pragma GCC optimize("fp-contract=off")
+#elif defined(__clang__)
+#pragma float_control(push)
+#pragma clang fp contract(off)
+#endif
+
+// activations of neurons
+// apply() is same code for compute_type_t<T> and for vectors of float (GCC
+// vector extensions: arithmetic with scalars and select by ?:), so it's
+// inlined into every kernel and vector kernels give same bits as scalar one
+// selects are same as max and min instructions (second value for NaN)
+// values are changed in place, so vectors aren't passed by value between
+// functions compiled for different instruction sets
+// write() writes statements computing activation of variable o to generated
+// header (see ActivatedSimpleNet::save_header())
+
+// write constant @c@ as float or double literal
+inline void write_constant(std::ostream& s, float c, bool is_float) {
+	s << std::hexfloat << (is_float ? c : double(c)) << std::defaultfloat
+	  << (is_float ? "f" : "");
+}
+
+// clamp @x@ to [lo, hi]
+template <typename V>
+[[gnu::always_inline]] constexpr void clamp_to(V& x, float lo, float hi) {
+	x = x > lo ? x : V{} + lo;
+	x = x < hi ? x : V{} + hi;
+}
+
+// x / (1 + |x|), activation used by default
+struct softsign {
+	// identifier stored in checkpoint
+	constexpr static std::uint32_t id = 0;
+
+	template <typename V>
+	[[gnu::always_inline]] constexpr static void apply(V& x) {
+		x = x / (1 + (x > 0 ? x : -x));
+	}
+
+	static void write(std::ostream& s, bool) {
+		s << "\t\to = o / (1 + (o > 0 ? o : -o));\n";
+	}
+};
+
+// x
+struct identity {
+	// identifier stored in checkpoint
+	constexpr static std::uint32_t id = 1;
+
+	template <typename V>
+	[[gnu::always_inline]] constexpr static void apply(V&) {}
+
+	static void write(std::ostream&, bool) {}
+};
+
+// max(x, 0)
+struct relu {
+	// identifier stored in checkpoint
+	constexpr static std::uint32_t id = 2;
+
+	template <typename V>
+	[[gnu::always_inline]] constexpr static void apply(V& x) {
+		x = x > 0 ? x : V{};
+	}
+
+	static void write(std::ostream& s, bool) {
+		s << "\t\to = o > 0 ? o : 0;\n";
+	}
+};
+
+// max(x, x * slope)
+struct leaky_relu {
+	// identifier stored in checkpoint
+	constexpr static std::uint32_t id = 3;
+	// slope of negative part
+	constexpr static float slope = 0.01f;
+
+	template <typename V>
+	[[gnu::always_inline]] constexpr static void apply(V& x) {
+		const V y = x * slope;
+		x = x > y ? x : y;
+	}
+
+	static void write(std::ostream& s, bool is_float) {
+		s << "\t\to = o > o * ";
+		write_constant(s, slope, is_float);
+		s << " ? o : o * ";
+		write_constant(s, slope, is_float);
+		s << ";\n";
+	}
+};
+
+// x clamped to [-1, 1]
+struct hard_tanh {
+	// identifier stored in checkpoint
+	constexpr static std::uint32_t id = 4;
+
+	template <typename V>
+	[[gnu::always_inline]] constexpr static void apply(V& x) {
+		clamp_to(x, -1.f, 1.f);
+	}
+
+	static void write(std::ostream& s, bool) {
+		s << "\t\to = o > -1 ? o : -1;\n"
+		  << "\t\to = o < 1 ? o : 1;\n";
+	}
+};
+
+// odd polynomial of 9th degree approximating tanh(x) on [-3, 3] (x is
+// clamped to it), it's monotonic up to rounding (reaches 1 with zero slope
+// at 3) and its error is below 0.009
+struct tanh_approx {
+	// identifier stored in checkpoint
+	constexpr static std::uint32_t id = 5;
+	// range of x
+	constexpr static float limit = 3.f;
+	// coefficients of x, x^3, ..., x^9
+	constexpr static float c[5] = {0.964611843f, -0.232716042f, 0.0395774545f,
+								   -0.00341105880f, 0.000113405566f};
+
+	template <typename V>
+	[[gnu::always_inline]] constexpr static void apply(V& x) {
+		clamp_to(x, -limit, limit);
+		const V x2 = x * x;
+		x = x * (c[0] + x2 * (c[1] + x2 * (c[2] + x2 * (c[3] + x2 * c[4]))));
+		clamp_to(x, -1.f, 1.f);
+	}
+
+	static void write(std::ostream& s, bool is_float) {
+		s << "\t\to = o > ";
+		write_constant(s, -limit, is_float);
+		s << " ? o : ";
+		write_constant(s, -limit, is_float);
+		s << ";\n\t\to = o < ";
+		write_constant(s, limit, is_float);
+		s << " ? o : ";
+		write_constant(s, limit, is_float);
+		s << ";\n\t\to = o * (";
+		for (std::size_t i = 0; i < std::size(c); ++i) {
+			write_constant(s, c[i], is_float);
+			s << (i + 1 < std::size(c) ? " + o * o * (" : "");
+		}
+		s << std::string(std::size(c), ')') << ";\n"
+		  << "\t\to = o > -1 ? o : -1;\n"
+		  << "\t\to = o < 1 ? o : 1;\n";
+	}
+};
+
+// 1 / (1 + e^-x) computed as 0.5 + 0.5 * tanh_approx(0.5 * x)
+struct sigmoid_approx {
+	// identifier stored in checkpoint
+	constexpr static std::uint32_t id = 6;
+
+	template <typename V>
+	[[gnu::always_inline]] constexpr static void apply(V& x) {
+		x = x * 0.5f;
+		tanh_approx::apply(x);
+		x = 0.5f + 0.5f * x;
+	}
+
+	static void write(std::ostream& s, bool is_float) {
+		s << "\t\to = o * ";
+		write_constant(s, 0.5f, is_float);
+		s << ";\n";
+		tanh_approx::write(s, is_float);
+		s << "\t\to = ";
+		write_constant(s, 0.5f, is_float);
+		s << " + ";
+		write_constant(s, 0.5f, is_float);
+		s << " * o;\n";
+	}
+};
+
+// activations of layers (activation of first layer of neurons is first)
+template <typename... As>
+struct activations {
+	// number of layers
+	constexpr static std::size_t size = sizeof...(As);
+	// code of activations stored in checkpoint (0 if all of them are
+	// softsign)
+	constexpr static std::uint32_t code = [] {
+		if (((As::id == 0) && ...))
+			return std::uint32_t{0};
+		std::uint32_t h = 0x811c9dc5;
+		((h = (h ^ As::id) * 0x01000193), ...);
+		return (h & 0xffffff) | 1;
+	}();
+	// write() of each layer
+	constexpr static std::array<void (*)(std::ostream&, bool), size> writers{
+		As::write...};
+	// activation of layer L
+	template <std::size_t L>
+	using layer = std::tuple_element_t<L, std::tuple<As...>>;
+};
+
+// activations<A, A, ...> of N layers
+template <typename A, std::size_t N, typename... As>
+struct repeat_activation : repeat_activation<A, N - 1, A, As...> {};
+
+template <typename A, typename... As>
+struct repeat_activation<A, 0, As...> {
+	using type = activations<As...>;
+};
+
 // class Neuron contained pointers (no ownership) to his data
-template <std::size_t IN>
+// data is stored as T and computed as compute_type_t<T>, A is activation
+template <std::size_t IN, typename T = store_type, typename A = softsign>
 class Neuron {
    public:
 	// type of input
-	using feed_type = array<store_type, IN>;
+	using feed_type = array<compute_type_t<T>, IN>;
 	// type of output
-	using result_type = store_type;
+	using result_type = compute_type_t<T>;
 
-	// number of store_type what it need
+	// number of T what it need
 	constexpr static auto data_size = IN * 2;
 	// size of input data
 	constexpr static auto in_size = IN;
@@ -202,31 +682,490 @@ class Neuron {
 	constexpr static auto out_size = 1;
 
 	// construct Neuron
-	constexpr Neuron(store_type* data = nullptr) : ndata(data) {}
+	constexpr Neuron(const T* data = nullptr) : ndata(data) {}
 
 	// computing result
 	constexpr result_type proccess(const feed_type& data) const {
-		result_type o = 0.f;
+		return proccess(data.data());
+	}
+
+	// computing result from IN values
+	constexpr result_type proccess(const result_type* data) const {
+		result_type o = 0;
 		for (std::size_t i = 0; i < IN; ++i) {
-			o += data[i] * ndata[i << 1] + ndata[(i << 1) + 1];
+			o += data[i] * result_type(ndata[i << 1]) +
+				 result_type(ndata[(i << 1) + 1]);
 		}
-		return sigmoid(o);
+		A::apply(o);
+		return o;
 	}
 
    private:
 	// current neuron data
-	store_type* ndata;
+	const T* ndata;
+};
+
+// instruction sets used by layer kernels
+enum class simd { scalar, sse42, avx2, avx512 };
+
+// check instruction set is supported by current CPU
+inline bool simd_supported(simd s) {
+#if NET_X86_SIMD
+	switch (s) {
+		case simd::scalar:
+			return true;
+		case simd::sse42:
+			return __builtin_cpu_supports("sse4.2");
+		case simd::avx2:
+			return __builtin_cpu_supports("avx2");
+		case simd::avx512:
+			return __builtin_cpu_supports("avx512f");
+	}
+	return false;
+#else
+	return s == simd::scalar;
+#endif
+}
+
+// best instruction set supported by current CPU
+inline simd simd_best() {
+	static const simd best = [] {
+		for (auto s : {simd::avx512, simd::avx2, simd::sse42}) {
+			if (simd_supported(s))
+				return s;
+		}
+		return simd::scalar;
+	}();
+	return best;
+}
+
+// kernels computing Layer of OUT neurons with IN inputs
+// each kernel computes n rows of IN values into n rows of OUT values
+// neurons are spread over vector lanes and every lane sums its inputs in the
+// same order as Neuron does, so results are bit-identical to scalar kernel
+// (that's why FMA isn't used)
+// vector kernels are compiled only for data stored as float, other types are
+// computed by scalar kernel
+// activation A is inlined into every kernel
+template <std::size_t IN, std::size_t OUT, typename T = store_type,
+		  typename A = softsign>
+struct LayerKernel {
+	// type of computed values
+	using value_type = compute_type_t<T>;
+	// type of kernel function
+	using kernel_type = void (*)(const T* data, const value_type* in,
+								 std::size_t n, value_type* out);
+
+	// distance between same values of neighbouring neurons
+	constexpr static auto stride = Neuron<IN, T, A>::data_size;
+
+	// compute neurons from @first@ to OUT by Neuron
+	static void scalar_tail(const T* data, const value_type* in,
+							std::size_t n, value_type* out,
+							std::size_t first) {
+		for (std::size_t i = first; i < OUT; ++i) {
+			Neuron<IN, T, A> neuron{data + i * stride};
+			for (std::size_t s = 0; s < n; ++s) {
+				out[s * OUT + i] = neuron.proccess(in + s * IN);
+			}
+		}
+	}
+
+	static void scalar(const T* data, const value_type* in, std::size_t n,
+					   value_type* out) {
+		scalar_tail(data, in, n, out, 0);
+	}
+
+#if NET_X86_SIMD
+	// rows of 2 inputs of 4 neurons are loaded and transposed, same as by
+	// avx2 kernel
+	__attribute__((target("sse4.2"))) static void sse42(const store_type* data,
+														  const store_type* in,
+														  std::size_t n,
+														  store_type* out) {
+		constexpr std::size_t W = 4;
+		constexpr std::size_t vec_end = OUT - OUT % W;
+		constexpr std::size_t in_end = IN - IN % 2;
+		for (std::size_t j = 0; j < vec_end; j += W) {
+			const auto* nd = data + j * stride;
+			for (std::size_t s = 0; s < n; ++s) {
+				const auto* x = in + s * IN;
+				__m128 o = _mm_setzero_ps();
+				for (std::size_t i = 0; i < in_end; i += 2) {
+					const auto* p = nd + (i << 1);
+					__m128 w0 = _mm_loadu_ps(p);
+					__m128 b0 = _mm_loadu_ps(p + stride);
+					__m128 w1 = _mm_loadu_ps(p + 2 * stride);
+					__m128 b1 = _mm_loadu_ps(p + 3 * stride);
+					_MM_TRANSPOSE4_PS(w0, b0, w1, b1);
+					o = _mm_add_ps(
+						o, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(x[i]), w0), b0));
+					o = _mm_add_ps(
+						o,
+						_mm_add_ps(_mm_mul_ps(_mm_set1_ps(x[i + 1]), w1), b1));
+				}
+				if constexpr (in_end != IN) {
+					const auto* p = nd + (in_end << 1);
+					__m128 w = _mm_setr_ps(p[0], p[stride], p[2 * stride],
+										   p[3 * stride]);
+					__m128 b = _mm_setr_ps(p[1], p[stride + 1],
+										   p[2 * stride + 1],
+										   p[3 * stride + 1]);
+					o = _mm_add_ps(
+						o,
+						_mm_add_ps(_mm_mul_ps(_mm_set1_ps(x[in_end]), w), b));
+				}
+				A::apply(o);
+				_mm_storeu_ps(out + s * OUT + j, o);
+			}
+		}
+		if constexpr (vec_end != OUT) {
+			scalar_tail(data, in, n, out, vec_end);
+		}
+	}
+
+	// transpose 8 x 8 matrix of rows r
+	// rows are 4 (weight, bias) pairs of 8 neurons, so r becomes weights and
+	// biases of 4 inputs spread over neurons: r[2 * k] are weights and
+	// r[2 * k + 1] biases of input k
+	__attribute__((target("avx2"), always_inline)) static inline void
+	transpose8(__m256* r) {
+		__m256 t[8], u[8];
+		for (int k = 0; k < 8; k += 2) {
+			t[k] = _mm256_unpacklo_ps(r[k], r[k + 1]);
+			t[k + 1] = _mm256_unpackhi_ps(r[k], r[k + 1]);
+		}
+		for (int k = 0; k < 8; k += 4) {
+			u[k] = _mm256_shuffle_ps(t[k], t[k + 2], _MM_SHUFFLE(1, 0, 1, 0));
+			u[k + 1] =
+				_mm256_shuffle_ps(t[k], t[k + 2], _MM_SHUFFLE(3, 2, 3, 2));
+			u[k + 2] =
+				_mm256_shuffle_ps(t[k + 1], t[k + 3], _MM_SHUFFLE(1, 0, 1, 0));
+			u[k + 3] =
+				_mm256_shuffle_ps(t[k + 1], t[k + 3], _MM_SHUFFLE(3, 2, 3, 2));
+		}
+		for (int k = 0; k < 4; ++k) {
+			r[k] = _mm256_permute2f128_ps(u[k], u[k + 4], 0x20);
+			r[k + 4] = _mm256_permute2f128_ps(u[k], u[k + 4], 0x31);
+		}
+	}
+
+	// weights (or biases if @bias@) of input of 8 neurons starting at @p@
+	// by scalar loads, used for inputs left after blocks of 4 inputs
+	__attribute__((target("avx2"), always_inline)) static inline __m256
+	lanes8(const store_type* p, int bias) {
+		p += bias;
+		return _mm256_setr_ps(p[0], p[stride], p[2 * stride], p[3 * stride],
+							  p[4 * stride], p[5 * stride], p[6 * stride],
+							  p[7 * stride]);
+	}
+
+	// weights and biases are loaded by contiguous rows of 4 inputs of each
+	// neuron and transposed in registers, no gathers are needed
+	__attribute__((target("avx2"))) static void avx2(const store_type* data,
+													 const store_type* in,
+													 std::size_t n,
+													 store_type* out) {
+		constexpr std::size_t W = 8;
+		constexpr std::size_t vec_end = OUT - OUT % W;
+		constexpr std::size_t in_end = IN - IN % 4;
+		for (std::size_t j = 0; j < vec_end; j += W) {
+			const auto* nd = data + j * stride;
+			for (std::size_t s = 0; s < n; ++s) {
+				const auto* x = in + s * IN;
+				__m256 o = _mm256_setzero_ps();
+				for (std::size_t i = 0; i < in_end; i += 4) {
+					__m256 r[8];
+					for (std::size_t k = 0; k < W; ++k) {
+						r[k] = _mm256_loadu_ps(nd + k * stride + (i << 1));
+					}
+					transpose8(r);
+					for (std::size_t k = 0; k < 4; ++k) {
+						o = _mm256_add_ps(
+							o, _mm256_add_ps(_mm256_mul_ps(
+												 _mm256_set1_ps(x[i + k]),
+												 r[2 * k]),
+											 r[2 * k + 1]));
+					}
+				}
+				for (std::size_t i = in_end; i < IN; ++i) {
+					const auto* p = nd + (i << 1);
+					o = _mm256_add_ps(
+						o, _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(x[i]),
+													   lanes8(p, 0)),
+										 lanes8(p, 1)));
+				}
+				A::apply(o);
+				_mm256_storeu_ps(out + s * OUT + j, o);
+			}
+		}
+		if constexpr (vec_end != OUT) {
+			scalar_tail(data, in, n, out, vec_end);
+		}
+	}
+
+	// transpose 16 x 16 matrix of rows r, same as transpose8() for 8 inputs
+	// of 16 neurons
+	__attribute__((target("avx512f"), always_inline)) static inline void
+	transpose16(__m512* r) {
+		// zero masked forms are used because unmasked ones of GCC headers
+		// pass undefined vector and warn by -Wmaybe-uninitialized
+		constexpr __mmask16 all = 0xffff;
+		__m512 t[16];
+		for (int k = 0; k < 16; k += 2) {
+			t[k] = _mm512_maskz_unpacklo_ps(all, r[k], r[k + 1]);
+			t[k + 1] = _mm512_maskz_unpackhi_ps(all, r[k], r[k + 1]);
+		}
+		for (int k = 0; k < 16; k += 4) {
+			r[k] = _mm512_shuffle_ps(t[k], t[k + 2], _MM_SHUFFLE(1, 0, 1, 0));
+			r[k + 1] =
+				_mm512_shuffle_ps(t[k], t[k + 2], _MM_SHUFFLE(3, 2, 3, 2));
+			r[k + 2] =
+				_mm512_shuffle_ps(t[k + 1], t[k + 3], _MM_SHUFFLE(1, 0, 1, 0));
+			r[k + 3] =
+				_mm512_shuffle_ps(t[k + 1], t[k + 3], _MM_SHUFFLE(3, 2, 3, 2));
+		}
+		for (int h = 0; h < 16; h += 8) {
+			for (int k = h; k < h + 4; ++k) {
+				t[k] = _mm512_maskz_shuffle_f32x4(all, r[k], r[k + 4], 0x88);
+				t[k + 4] =
+					_mm512_maskz_shuffle_f32x4(all, r[k], r[k + 4], 0xdd);
+			}
+		}
+		for (int k = 0; k < 8; ++k) {
+			r[k] = _mm512_maskz_shuffle_f32x4(all, t[k], t[k + 8], 0x88);
+			r[k + 8] = _mm512_maskz_shuffle_f32x4(all, t[k], t[k + 8], 0xdd);
+		}
+	}
+
+	// weights (or biases if @bias@) of input of 16 neurons starting at @p@
+	__attribute__((target("avx512f"), always_inline)) static inline __m512
+	lanes16(const store_type* p, int bias) {
+		p += bias;
+		return _mm512_setr_ps(p[0], p[stride], p[2 * stride], p[3 * stride],
+							  p[4 * stride], p[5 * stride], p[6 * stride],
+							  p[7 * stride], p[8 * stride], p[9 * stride],
+							  p[10 * stride], p[11 * stride], p[12 * stride],
+							  p[13 * stride], p[14 * stride], p[15 * stride]);
+	}
+
+	// same as avx2 kernel with rows of 8 inputs
+	__attribute__((target("avx512f"))) static void avx512(
+		const store_type* data, const store_type* in, std::size_t n,
+		store_type* out) {
+		constexpr std::size_t W = 16;
+		constexpr std::size_t vec_end = OUT - OUT % W;
+		constexpr std::size_t in_end = IN - IN % 8;
+		for (std::size_t j = 0; j < vec_end; j += W) {
+			const auto* nd = data + j * stride;
+			for (std::size_t s = 0; s < n; ++s) {
+				const auto* x = in + s * IN;
+				__m512 o = _mm512_setzero_ps();
+				for (std::size_t i = 0; i < in_end; i += 8) {
+					__m512 r[16];
+					for (std::size_t k = 0; k < W; ++k) {
+						r[k] = _mm512_loadu_ps(nd + k * stride + (i << 1));
+					}
+					transpose16(r);
+					for (std::size_t k = 0; k < 8; ++k) {
+						o = _mm512_add_ps(
+							o, _mm512_add_ps(_mm512_mul_ps(
+												 _mm512_set1_ps(x[i + k]),
+												 r[2 * k]),
+											 r[2 * k + 1]));
+					}
+				}
+				for (std::size_t i = in_end; i < IN; ++i) {
+					const auto* p = nd + (i << 1);
+					o = _mm512_add_ps(
+						o, _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(x[i]),
+													   lanes16(p, 0)),
+										 lanes16(p, 1)));
+				}
+				A::apply(o);
+				_mm512_storeu_ps(out + s * OUT + j, o);
+			}
+		}
+		if constexpr (vec_end != OUT) {
+			scalar_tail(data, in, n, out, vec_end);
+		}
+	}
+#endif
+
+	// return kernel for instruction set (nullptr if it isn't compiled)
+	static kernel_type get(simd s) {
+		if constexpr (not std::is_same_v<T, float>) {
+			return s == simd::scalar ? scalar : nullptr;
+		} else {
+			switch (s) {
+				case simd::scalar:
+					return scalar;
+#if NET_X86_SIMD
+				case simd::sse42:
+					return sse42;
+				case simd::avx2:
+					return avx2;
+				case simd::avx512:
+					return avx512;
+#else
+				default:
+					break;
+#endif
+			}
+			return nullptr;
+		}
+	}
+
+	// return kernel for best instruction set supported by current CPU
+	static kernel_type get() {
+		if constexpr (not std::is_same_v<T, float>) {
+			return scalar;
+		} else {
+			return get(simd_best());
+		}
+	}
+};
+
+// kernel computing dense layer of OUT neurons with IN inputs
+// data is row-major OUT x IN matrix of weights followed by OUT biases
+// neuron j computes A(x[0] * w[j][0] + ... + x[IN-1] * w[j][IN-1] +
+// bias[j]) summed in this order
+// samples are transposed by blocks of lanes, so every row of weights is read
+// once per block and each weight is broadcast to lanes of samples (compiler
+// vectorizes it without reordering sums, so every instruction set gives same
+// results)
+template <std::size_t IN, std::size_t OUT, typename T = store_type,
+		  typename A = softsign>
+struct DenseKernel {
+	// type of computed values
+	using value_type = compute_type_t<T>;
+	// type of kernel function
+	using kernel_type = void (*)(const T* data, const value_type* in,
+								 std::size_t n, value_type* out);
+
+	// number of samples computed together
+	constexpr static std::size_t lanes = 16;
+
+	static void scalar(const T* data, const value_type* in, std::size_t n,
+					   value_type* out) {
+		proccess(data, in, n, out);
+	}
+
+#if NET_X86_SIMD
+	__attribute__((target("avx2"))) static void avx2(const T* data,
+													 const value_type* in,
+													 std::size_t n,
+													 value_type* out) {
+		proccess(data, in, n, out);
+	}
+
+	__attribute__((target("avx512f"))) static void avx512(
+		const T* data, const value_type* in, std::size_t n, value_type* out) {
+		proccess(data, in, n, out);
+	}
+#endif
+
+	// return kernel for instruction set (nullptr if it isn't compiled)
+	// vector code of SSE4.2 is same as of baseline SSE2, so scalar kernel is
+	// used for it
+	static kernel_type get(simd s) {
+		switch (s) {
+			case simd::scalar:
+			case simd::sse42:
+				return scalar;
+#if NET_X86_SIMD
+			case simd::avx2:
+				return avx2;
+			case simd::avx512:
+				return avx512;
+#else
+			default:
+				break;
+#endif
+		}
+		return nullptr;
+	}
+
+	// return kernel for best instruction set supported by current CPU
+	static kernel_type get() { return get(simd_best()); }
+
+   private:
+	// compute n rows of IN values into n rows of OUT values
+	// it's inlined into kernels, so it's compiled for their instruction sets
+	__attribute__((always_inline)) static inline void proccess(
+		const T* data, const value_type* in, std::size_t n, value_type* out) {
+		const T* bias = data + IN * OUT;
+		for (std::size_t s0 = 0; s0 < n; s0 += lanes) {
+			const auto count = std::min(lanes, n - s0);
+			if (count == 1) {
+				single(data, in + s0 * IN, out + s0 * OUT);
+				continue;
+			}
+
+			// block of samples transposed, missing samples are zeros
+			value_type x[IN][lanes];
+			for (std::size_t i = 0; i < IN; ++i) {
+				for (std::size_t s = 0; s < lanes; ++s) {
+					x[i][s] = s < count ? in[(s0 + s) * IN + i] : 0;
+				}
+			}
+
+			for (std::size_t j = 0; j < OUT; ++j) {
+				const T* w = data + j * IN;
+				value_type o[lanes]{};
+				for (std::size_t i = 0; i < IN; ++i) {
+					const value_type wi = w[i];
+					for (std::size_t s = 0; s < lanes; ++s) {
+						o[s] += x[i][s] * wi;
+					}
+				}
+				const value_type b = bias[j];
+				for (std::size_t s = 0; s < lanes; ++s) {
+					o[s] = o[s] + b;
+					A::apply(o[s]);
+				}
+				for (std::size_t s = 0; s < count; ++s) {
+					out[(s0 + s) * OUT + j] = o[s];
+				}
+			}
+		}
+	}
+
+	// compute one sample
+	__attribute__((always_inline)) static inline void single(
+		const T* data, const value_type* x, value_type* y) {
+		const T* bias = data + IN * OUT;
+		for (std::size_t j = 0; j < OUT; ++j) {
+			value_type o = 0;
+			for (std::size_t i = 0; i < IN; ++i) {
+				o += x[i] * value_type(data[j * IN + i]);
+			}
+			o = o + value_type(bias[j]);
+			A::apply(o);
+			y[j] = o;
+		}
+	}
 };
 
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC pop_options
+#elif defined(__clang__)
+#pragma float_control(pop)
+#endif
+
 // class Layer contain Neurons
-template <std::size_t...>
+// data is stored as T, input, output and intermediate results are
+// compute_type_t<T>, As is activations<...> of this and next layers
+template <typename T, typename As, std::size_t...>
 class Layer;
 
 // end point of recurrent deriving of Layer
-template <std::size_t IN, std::size_t OUT>
-class Layer<IN, OUT> {
+template <typename T, typename A, std::size_t IN, std::size_t OUT>
+class Layer<T, activations<A>, IN, OUT> {
 	// type used neurons
-	using neuron_type = Neuron<IN>;
+	using neuron_type = Neuron<IN, T, A>;
+	// type of kernels
+	using kernel_set = LayerKernel<IN, OUT, T, A>;
 
    public:
 	// type of input data
@@ -234,53 +1173,48 @@ class Layer<IN, OUT> {
 	// type of output data
 	using result_type = array<typename neuron_type::result_type, OUT>;
 
-	// number of store_type what it need
+	// type of computed values
+	using value_type = typename neuron_type::result_type;
+
+	// number of T what it need
 	constexpr static auto data_size = neuron_type::data_size * OUT;
 	// size of input data
 	constexpr static auto in_size = neuron_type::in_size;
 	// size of output data
 	constexpr static auto out_size = OUT;
+	// size of buffer for intermediate results (last layer doesn't need it)
+	constexpr static std::size_t buffer_size = 0;
 
-	// construct Layer and inner neurons
-	constexpr Layer(store_type* data)
-		: neurons(reinterpret_cast<neuron_type*>(operator new[](
-			  OUT * sizeof(neuron_type)))) {
-		for (std::size_t i = 0; i < OUT; ++i) {
-			new (neurons + i) neuron_type(data);
-			data += neuron_type::data_size;
-		}
-	}
-
-	// destruct Layer with inner neurons
-	constexpr ~Layer() { operator delete[](neurons); }
-
-	// compute result
-	constexpr result_type proccess(feed_type& data) const {
-		result_type o{};
-
-		for (std::size_t i = 0; i < OUT; ++i) {
-			o[i] = neurons[i].proccess(data);
-		}
-
-		data.release();
+	// construct Layer over neurons data
+	// kernel is selected for best instruction set supported by current CPU
+	constexpr Layer(T* data) : ldata(data), kernel(kernel_set::get()) {}
 
-		return o;
+	// compute results from n rows of IN values into n rows of OUT values
+	// each group of neurons is applied to all rows, so its data is loaded
+	// once per call
+	// buffers are unused, they are needed by recurrent Layer
+	constexpr void proccess(const value_type* in, std::size_t n,
+							value_type* out, value_type*, value_type*) const {
+		kernel(ldata, in, n, out);
 	}
 
    private:
-	// neurons
-	neuron_type* neurons;
+	// neurons data
+	const T* ldata;
+	// kernel computing neurons
+	typename kernel_set::kernel_type kernel;
 };
 
 // recurrent Layer
-template <std::size_t IN, std::size_t OUT, std::size_t... Ss>
-class Layer<IN, OUT, Ss...> {
+template <typename T, typename A, typename... As, std::size_t IN,
+		  std::size_t OUT, std::size_t... Ss>
+class Layer<T, activations<A, As...>, IN, OUT, Ss...> {
 	// type of base class
-	using base_type = Layer<IN, OUT>;
+	using base_type = Layer<T, activations<A>, IN, OUT>;
 	// type of stored class
-	using next_layer_type = Layer<OUT, Ss...>;
+	using next_layer_type = Layer<T, activations<As...>, OUT, Ss...>;
 
-	// number of store_type what base_type need
+	// number of T what base_type need
 	constexpr static auto base_data_size = base_type::data_size;
 
    public:
@@ -288,183 +1222,2339 @@ class Layer<IN, OUT, Ss...> {
 	using feed_type = typename base_type::feed_type;
 	// type of output data
 	using result_type = typename next_layer_type::result_type;
+	// type of computed values
+	using value_type = typename base_type::value_type;
 
-	// number of store_type what it need
+	// number of T what it need
 	constexpr static auto data_size =
 		base_type::data_size + next_layer_type::data_size;
 	// size of input data
 	constexpr static auto in_size = base_type::in_size;
 	// size of output data
 	constexpr static auto out_size = next_layer_type::out_size;
+	// size of each of two buffers for intermediate results
+	constexpr static std::size_t buffer_size =
+		std::max<std::size_t>(OUT, next_layer_type::buffer_size);
 
 	// construct base and stored Layer
-	constexpr Layer(store_type* data)
-		: base(data), next_layer(data + base_data_size) {}
+	constexpr Layer(T* data) : base(data), next_layer(data + base_data_size) {}
 
-	constexpr result_type proccess(feed_type& data) const {
-		auto tmp = base.proccess(data);
-		data.release();
-		return next_layer.proccess(tmp);
+	// compute results from n rows of IN values into out
+	// intermediate results ping-pong between buf_a and buf_b
+	// each buffer should contain n * buffer_size values
+	constexpr void proccess(const value_type* in, std::size_t n,
+							value_type* out, value_type* buf_a,
+							value_type* buf_b) const {
+		base.proccess(in, n, buf_a, nullptr, nullptr);
+		next_layer.proccess(buf_a, n, out, buf_b, buf_a);
 	}
 
    private:
 	base_type base;
 	next_layer_type next_layer;
 };
-}  // namespace
 
-// class SimpleNet contain first layer (but it contain next layer and etc).
-// class SimpleNet contain data for neurons
-template <std::size_t... Ss>
-requires(sizeof...(Ss) >= 2) class SimpleNet {
+// class DenseLayer contain row-major matrix of weights and bias of each neuron
+// data is stored as T, input, output and intermediate results are
+// compute_type_t<T>, As is activations<...> of this and next layers
+template <typename T, typename As, std::size_t...>
+class DenseLayer;
+
+// end point of recurrent deriving of DenseLayer
+template <typename T, typename A, std::size_t IN, std::size_t OUT>
+class DenseLayer<T, activations<A>, IN, OUT> {
    public:
-	// type of first layer
-	using layer_type = Layer<Ss...>;
-	// type of output data
-	using result_type = typename layer_type::result_type;
+	// type of computed values
+	using value_type = compute_type_t<T>;
 	// type of input data
-	using feed_type = typename layer_type::feed_type;
+	using feed_type = array<value_type, IN>;
+	// type of output data
+	using result_type = array<value_type, OUT>;
 
-	// number of store_type what all layers are contain
-	constexpr static auto data_size = layer_type::data_size;
+	// number of T what it need (weights and biases)
+	constexpr static auto data_size = IN * OUT + OUT;
 	// size of input data
-	constexpr static auto in_size = layer_type::in_size;
+	constexpr static auto in_size = IN;
 	// size of output data
-	constexpr static auto out_size = layer_type::out_size;
-
-	// construct SimpleNet
-	// allocate neuron data
-	// allocate first layer
-	constexpr SimpleNet()
-		: data(new store_type[data_size]), layer(new layer_type(data)) {}
-
-	// copy constructor
-	constexpr SimpleNet(const SimpleNet& other) : SimpleNet() { *this = other; }
+	constexpr static auto out_size = OUT;
+	// size of buffer for intermediate results (last layer doesn't need it)
+	constexpr static std::size_t buffer_size = 0;
 
-	// deallocate store
-	constexpr ~SimpleNet() {
-		delete layer;
-		delete[] data;
-	}
+	// construct DenseLayer over its data
+	// kernel is selected for best instruction set supported by current CPU
+	constexpr DenseLayer(T* data)
+		: ldata(data), kernel(DenseKernel<IN, OUT, T, A>::get()) {}
 
-	// compute result
-	constexpr result_type operator()(const feed_type& data) const {
-		return proccess(data);
+	// compute results from n rows of IN values into n rows of OUT values
+	// buffers are unused, they are needed by recurrent DenseLayer
+	constexpr void proccess(const value_type* in, std::size_t n,
+							value_type* out, value_type*, value_type*) const {
+		kernel(ldata, in, n, out);
 	}
 
-	// copy data from other SimpleNet
-	constexpr SimpleNet& operator=(const SimpleNet& other) {
-		std::memcpy(data, other.data, data_size * sizeof(store_type));
-
-		return *this;
-	}
+   private:
+	// weights and biases
+	const T* ldata;
+	// kernel computing neurons
+	typename DenseKernel<IN, OUT, T, A>::kernel_type kernel;
+};
 
-	// check SimpleNets are equal
-	constexpr bool operator==(const SimpleNet& other) const {
-		return 0 ==
-			   std::memcmp(data, other.data, data_size * sizeof(store_type));
-	}
+// recurrent DenseLayer
+template <typename T, typename A, typename... As, std::size_t IN,
+		  std::size_t OUT, std::size_t... Ss>
+class DenseLayer<T, activations<A, As...>, IN, OUT, Ss...> {
+	// type of base class
+	using base_type = DenseLayer<T, activations<A>, IN, OUT>;
+	// type of stored class
+	using next_layer_type = DenseLayer<T, activations<As...>, OUT, Ss...>;
 
-	// wrapper for merge()
-	SimpleNet operator+(const SimpleNet& other) const { return merge(other); }
+   public:
+	// type of input data
+	using feed_type = typename base_type::feed_type;
+	// type of output data
+	using result_type = typename next_layer_type::result_type;
+	// type of computed values
+	using value_type = typename base_type::value_type;
+
+	// number of T what it need
+	constexpr static auto data_size =
+		base_type::data_size + next_layer_type::data_size;
+	// size of input data
+	constexpr static auto in_size = base_type::in_size;
+	// size of output data
+	constexpr static auto out_size = next_layer_type::out_size;
+	// size of each of two buffers for intermediate results
+	constexpr static std::size_t buffer_size =
+		std::max<std::size_t>(OUT, next_layer_type::buffer_size);
+
+	// construct base and stored DenseLayer
+	constexpr DenseLayer(T* data)
+		: base(data), next_layer(data + base_type::data_size) {}
+
+	// compute results from n rows of IN values into out
+	// intermediate results ping-pong between buf_a and buf_b
+	// each buffer should contain n * buffer_size values
+	constexpr void proccess(const value_type* in, std::size_t n,
+							value_type* out, value_type* buf_a,
+							value_type* buf_b) const {
+		base.proccess(in, n, buf_a, nullptr, nullptr);
+		next_layer.proccess(buf_a, n, out, buf_b, buf_a);
+	}
+
+   private:
+	base_type base;
+	next_layer_type next_layer;
+};
+
+// FNV-1a hash of n bytes
+constexpr std::uint64_t checksum(const void* data, std::size_t n,
+								 std::uint64_t hash = 0xcbf29ce484222325) {
+	const auto* bytes = static_cast<const unsigned char*>(data);
+	for (std::size_t i = 0; i < n; ++i) {
+		hash = (hash ^ bytes[i]) * 0x100000001b3;
+	}
+	return hash;
+}
+
+// fast hash of n bytes by 8 byte words (tail is padded by zeros)
+// it's used for finding networks with same data
+inline std::uint64_t words_hash(const void* data, std::size_t n) {
+	constexpr std::uint64_t k = 0x9e3779b97f4a7c15;
+	const auto* bytes = static_cast<const unsigned char*>(data);
+	std::uint64_t hash = n * k;
+	std::size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		std::uint64_t word;
+		std::memcpy(&word, bytes + i, 8);
+		hash = (hash ^ word) * k;
+		hash ^= hash >> 29;
+	}
+	std::uint64_t tail = 0;
+	std::memcpy(&tail, bytes + i, n - i);
+	hash = (hash ^ tail) * k;
+	return hash ^ (hash >> 32);
+}
+
+// check that @count@ items of @item@ bytes starting at @offset@ fit in @size@
+// bytes, it's used for fields read from files: they are checked by division,
+// so crafted values can't overflow
+constexpr bool fits_in(std::uint64_t size, std::uint64_t offset,
+					   std::uint64_t count, std::uint64_t item) {
+	return offset <= size && (item == 0 || count <= (size - offset) / item);
+}
+
+// copy n values of src to dst, dst can be same as src
+template <typename T>
+constexpr void copy_values(T* dst, const T* src, std::size_t n) {
+	if (dst != src && n != 0)
+		std::memmove(dst, src, n * sizeof(T));
+}
+
+// write crossover of n values of a and b into out by @type@
+// out can be same as a or b; every kernel is one pass over memory
+// multi_point crossover uses @points@ random points
+// blend is computed as compute_type_t<T> and rounded to T
+template <typename T, typename URBG>
+void crossover(T* out, const T* a, const T* b, std::size_t n,
+			   crossover_type type, std::size_t points, URBG& gen) {
+	std::uniform_int_distribution<std::size_t> rand_index(0, n - 1);
+
+	switch (type) {
+		case crossover_type::two_point: {
+			auto r = rand_index(gen);
+			auto l = rand_index(gen);
+			if (l > r)
+				std::swap(l, r);
+
+			copy_values(out, a, l);
+			copy_values(out + l, b + l, r - l);
+			copy_values(out + r, a + r, n - r);
+			break;
+		}
+		case crossover_type::uniform: {
+			// 64 choices from each random word, select is branchless so
+			// compiler vectorizes it; word is drawn by distribution, so
+			// generators of 32 bits give 64 random bits too
+			std::uniform_int_distribution<std::uint64_t> rand_bits;
+			for (std::size_t i = 0; i < n; i += 64) {
+				std::uint64_t bits = rand_bits(gen);
+				auto end = std::min<std::size_t>(i + 64, n);
+				for (auto j = i; j < end; ++j) {
+					bool from_b = (bits >> (j - i)) & 1;
+					out[j] = from_b ? b[j] : a[j];
+				}
+			}
+			break;
+		}
+		case crossover_type::multi_point: {
+			constexpr std::size_t max_points = 64;
+			std::size_t cuts[max_points + 1];
+			points = std::min(points, max_points);
+			for (std::size_t i = 0; i < points; ++i) {
+				cuts[i] = rand_index(gen);
+			}
+			std::sort(cuts, cuts + points);
+			cuts[points] = n;
+
+			std::size_t begin = 0;
+			for (std::size_t i = 0; i <= points; ++i) {
+				const auto* src = i & 1 ? b : a;
+				copy_values(out + begin, src + begin, cuts[i] - begin);
+				begin = cuts[i];
+			}
+			break;
+		}
+		case crossover_type::blend: {
+			using value_type = compute_type_t<T>;
+			std::uniform_real_distribution<value_type> rand_t;
+			const auto t = rand_t(gen);
+			for (std::size_t i = 0; i < n; ++i) {
+				const value_type x = a[i], y = b[i];
+				out[i] = static_cast<T>(x + t * (y - x));
+			}
+			break;
+		}
+	}
+}
+
+// fill n values by random values from [0, 1) of generator @gen@
+template <typename T, typename URBG>
+void rand_values(T* data, std::size_t n, URBG& gen) {
+	using value_type = compute_type_t<T>;
+	std::uniform_real_distribution<value_type> rand;
+	for (std::size_t i = 0; i < n; ++i) {
+		data[i] = static_cast<T>(rand(gen));
+	}
+}
+
+// mutate n values at random index @count@ times by generator @gen@
+// mutation is added as compute_type_t<T> and rounded to T, narrower T
+// saturates at its largest finite value instead of becoming infinity
+template <typename T, typename URBG>
+void mutate_values(T* data, std::size_t n, std::size_t count, URBG& gen) {
+	using value_type = compute_type_t<T>;
+	std::uniform_int_distribution<std::size_t> rand_index(0, n - 1);
+	std::uniform_real_distribution<value_type> rand_mutation(-mutk, mutk);
+
+	for (std::size_t i = 0; i < count; ++i) {
+		auto mut_idx = rand_index(gen);
+		value_type value = data[mut_idx];
+		value += rand_mutation(gen);
+		if constexpr (not std::is_same_v<T, value_type>) {
+			value = std::clamp<value_type>(value, -T::max, T::max);
+		}
+		data[mut_idx] = static_cast<T>(value);
+	}
+}
+
+// class ActivatedSimpleNet contain first layer (but it contain next layer and
+// etc).
+// class ActivatedSimpleNet contain data for neurons stored as T
+// T can be float, double, half or bfloat16 (half and bfloat16 are computed as
+// float, so their networks take half of memory of float ones)
+// As is activations<...> with activation of each layer of neurons
+template <typename T, typename As, std::size_t... Ss>
+requires(sizeof...(Ss) >= 2 && As::size + 1 == sizeof...(Ss)) class
+	ActivatedSimpleNet {
+   public:
+	// type of stored data
+	using storage_type = T;
+	// type of input, output and computed values
+	using value_type = compute_type_t<T>;
+	// type of first layer
+	using layer_type = Layer<T, As, Ss...>;
+	// type of output data
+	using result_type = typename layer_type::result_type;
+	// type of input data
+	using feed_type = typename layer_type::feed_type;
+
+	// number of T what all layers are contain
+	constexpr static auto data_size = layer_type::data_size;
+	// sizes of layers
+	constexpr static std::array<std::size_t, sizeof...(Ss)> layer_sizes{Ss...};
+	// size of input data
+	constexpr static auto in_size = layer_type::in_size;
+	// size of output data
+	constexpr static auto out_size = layer_type::out_size;
+	// number of samples computed together by proccess_batch()
+	constexpr static std::size_t batch_size = 16;
+	// number of value_type needed by proccess_batch() for intermediate results
+	constexpr static std::size_t workspace_size =
+		batch_size * layer_type::buffer_size * 2;
+	// activations of layers
+	using activations_type = As;
+	// layout of data stored in checkpoint (weight and bias for each input)
+	// and code of activations
+	constexpr static std::uint32_t layout = As::code << 8;
+
+	// construct ActivatedSimpleNet
+	// allocate neuron data
+	// construct first layer
+	constexpr ActivatedSimpleNet()
+		: data(new T[data_size]), owner(true), layer(data) {}
+
+	// construct ActivatedSimpleNet over external storage of data_size values
+	// storage isn't owned by ActivatedSimpleNet and should outlive it
+	explicit constexpr ActivatedSimpleNet(T* storage)
+		: data(storage), owner(false), layer(data) {}
+
+	// copy constructor (copy always owns its data)
+	constexpr ActivatedSimpleNet(const ActivatedSimpleNet& other)
+		: ActivatedSimpleNet() {
+		*this = other;
+	}
+
+	// move constructor
+	// takes data if other owns it, otherwise copies it (external storage
+	// stays with other)
+	// moved-from ActivatedSimpleNet can only be assigned or destroyed
+	constexpr ActivatedSimpleNet(ActivatedSimpleNet&& other)
+		: data(other.owner ? other.data : new T[data_size]),
+		  owner(true),
+		  layer(data) {
+		if (other.owner) {
+			other.data = nullptr;
+		} else {
+			*this = other;
+		}
+	}
+
+	// deallocate store
+	constexpr ~ActivatedSimpleNet() {
+		if (owner) {
+			delete[] data;
+		}
+	}
+
+	// compute result
+	constexpr result_type operator()(const feed_type& data) const {
+		return proccess(data);
+	}
+
+	// neurons data
+	std::span<const T, data_size> weights() const noexcept {
+		return std::span<const T, data_size>{data, data_size};
+	}
+
+	// copy data from other ActivatedSimpleNet
+	// other can't be moved-from ActivatedSimpleNet (it has no data)
+	constexpr ActivatedSimpleNet& operator=(const ActivatedSimpleNet& other) {
+		assert(other.data != nullptr);
+		if (data == nullptr) {
+			// moved-from ActivatedSimpleNet
+			data = new T[data_size];
+			layer = layer_type(data);
+		}
+		std::memcpy(data, other.data, data_size * sizeof(T));
+
+		return *this;
+	}
+
+	// swap data with other ActivatedSimpleNet if both own data, otherwise copy
+	// data (external storage is never exchanged)
+	constexpr ActivatedSimpleNet& operator=(ActivatedSimpleNet&& other) {
+		if (not(owner && other.owner)) {
+			return *this = other;
+		}
+
+		std::swap(data, other.data);
+		layer = layer_type(data);
+		other.layer = layer_type(other.data);
+
+		return *this;
+	}
+
+	// check SimpleNets are equal
+	constexpr bool operator==(const ActivatedSimpleNet& other) const {
+		return 0 ==
+			   std::memcmp(data, other.data, data_size * sizeof(T));
+	}
+
+	// wrapper for merge()
+	ActivatedSimpleNet operator+(const ActivatedSimpleNet& other) const {
+		return merge(other);
+	}
+
+	// wrapper for mutation()
+	ActivatedSimpleNet& operator+(int mut) { return mutation(mut); }
 
 	// wrapper for mutation()
-	SimpleNet& operator+(int mut) { return mutation(mut); }
+	ActivatedSimpleNet& operator++() { return mutation(); }
+
+	// wrapper for mutation()
+	ActivatedSimpleNet operator++(int z) {
+		ActivatedSimpleNet o{*this};
+		mutation(z ? z : 1);
+		return o;
+	}
+
+	// randomize network by generator of current thread
+	void rand() { rand(thread_random()); }
+
+	// randomize network by generator @gen@
+	template <typename URBG>
+	void rand(URBG& gen) {
+		rand_values(data, data_size, gen);
+	}
+
+	// merge networks by random indexes from generator of current thread
+	ActivatedSimpleNet merge(const ActivatedSimpleNet& other) const {
+		return merge(other, thread_random());
+	}
+
+	// merge networks by random indexes from generator @gen@
+	template <typename URBG>
+	ActivatedSimpleNet merge(const ActivatedSimpleNet& other, URBG& gen) const {
+		ActivatedSimpleNet o;
+		o.crossover(*this, other, gen);
+		return o;
+	}
+
+	// write crossover of @a@ and @b@ into this network in place
+	// this network can be one of parents
+	// multi_point crossover uses @points@ random points
+	template <typename URBG>
+	ActivatedSimpleNet& crossover(
+		const ActivatedSimpleNet& a, const ActivatedSimpleNet& b, URBG& gen,
+		crossover_type type = crossover_type::two_point,
+		std::size_t points = 4) {
+		net::crossover(data, a.data, b.data, data_size, type, points, gen);
+		return *this;
+	}
+
+	// mutate stored neurons data at random index @count@ times
+	// by generator of current thread
+	ActivatedSimpleNet& mutation(std::size_t count = 1) {
+		return mutation(count, thread_random());
+	}
+
+	// mutate stored neurons data at random index @count@ times
+	// by generator @gen@
+	// mutation is added as value_type and rounded to T, narrower T saturates
+	// at its largest finite value instead of becoming infinity
+	template <typename URBG>
+	ActivatedSimpleNet& mutation(std::size_t count, URBG& gen) {
+		mutate_values(data, data_size, count, gen);
+		return *this;
+	}
+
+	// compute result
+	result_type proccess(const feed_type& data) const {
+		result_type o;
+		proccess(data.data(), o.data());
+		return o;
+	}
+
+	// compute result from in_size values into out_size values
+	// intermediate results are stored on stack, no memory is allocated
+	void proccess(const value_type* in, value_type* out) const {
+		std::array<value_type, layer_type::buffer_size> buf_a, buf_b;
+		layer.proccess(in, 1, out, buf_a.data(), buf_b.data());
+	}
+
+	// compute results for n samples
+	// in contains n rows of in_size values, out receives n rows of out_size
+	// samples are computed by blocks of batch_size, so each weight is loaded
+	// once per block instead of once per sample
+	void proccess_batch(const value_type* in, std::size_t n,
+						value_type* out) const {
+		std::vector<value_type> workspace(workspace_size);
+		proccess_batch(in, n, out, workspace.data());
+	}
+
+	// compute results for n samples using workspace of workspace_size values
+	// for intermediate results, no memory is allocated
+	void proccess_batch(const value_type* in, std::size_t n, value_type* out,
+						value_type* workspace) const {
+		constexpr auto block = batch_size * layer_type::buffer_size;
+
+		for (std::size_t s = 0; s < n; s += batch_size) {
+			auto count = std::min(batch_size, n - s);
+			layer.proccess(in + s * in_size, count, out + s * out_size,
+						   workspace, workspace + block);
+		}
+	}
+
+	// compute results for each sample of in into out
+	void proccess_batch(std::span<const feed_type> in,
+						std::span<result_type> out) const {
+		static_assert(sizeof(feed_type) == in_size * sizeof(value_type));
+		static_assert(sizeof(result_type) == out_size * sizeof(value_type));
+
+		if (in.size() != out.size()) {
+			throw std::invalid_argument{
+				"net::SimpleNet::proccess_batch sizes of in and out differ"};
+		}
+		if (not in.empty()) {
+			proccess_batch(in.data()->data(), in.size(), out.data()->data());
+		}
+	}
+
+	// write self-contained C++ header computing this network to @s@
+	// data of neurons is written as constexpr arrays of value_type in
+	// namespace @name@ and evaluate() is unrolled, so compiler can fold data
+	// into instructions
+	// header doesn't include Net.hh, it computes neurons in same order as
+	// Neuron does
+	void save_header(std::ostream& s, std::string_view name) const {
+		constexpr bool is_float = std::is_same_v<value_type, float>;
+		const char* type = is_float ? "float" : "double";
+
+		auto value = [&](value_type v) {
+			if (not std::isfinite(v)) {
+				throw std::invalid_argument{
+					"net::SimpleNet::save_header data should be finite"};
+			}
+			s << std::hexfloat << v << std::defaultfloat
+			  << (is_float ? "f" : "");
+		};
+
+		s << "// generated by net::SimpleNet::save_header\n"
+		  << "#pragma once\n\n"
+		  << "#include <array>\n"
+		  << "#include <cstddef>\n\n"
+		  << "namespace " << name << " {\n"
+		  << "// sizes of layers\n"
+		  << "inline constexpr std::size_t layer_sizes[] = {";
+		for (std::size_t i = 0; i < layer_sizes.size(); ++i) {
+			s << (i ? ", " : "") << layer_sizes[i];
+		}
+		s << "};\n"
+		  << "// size of input data\n"
+		  << "inline constexpr std::size_t in_size = " << in_size << ";\n"
+		  << "// size of output data\n"
+		  << "inline constexpr std::size_t out_size = " << out_size << ";\n";
+
+		// data of layers, every neuron has weight and bias for each input
+		const T* p = data;
+		for (std::size_t l = 0; l + 1 < layer_sizes.size(); ++l) {
+			const auto count = layer_sizes[l] * layer_sizes[l + 1] * 2;
+			s << "\n// data of layer " << l
+			  << " (weight and bias for each input of each neuron)\n"
+			  << "alignas(64) inline constexpr " << type << " layer" << l
+			  << "[" << count << "] = {";
+			for (std::size_t i = 0; i < count; ++i) {
+				s << (i % 4 ? " " : "\n\t");
+				value(p[i]);
+				s << ",";
+			}
+			s << "\n};\n";
+			p += count;
+		}
+
+		s << "\n// compute out_size results from in_size values\n"
+		  << "constexpr void evaluate(const " << type << "* in, " << type
+		  << "* out) {\n";
+		for (std::size_t l = 1; l + 1 < layer_sizes.size(); ++l) {
+			s << "\t" << type << " x" << l << "[" << layer_sizes[l]
+			  << "]{};\n";
+		}
+		for (std::size_t l = 0; l + 1 < layer_sizes.size(); ++l) {
+			const auto in = l ? "x" + std::to_string(l) : std::string{"in"};
+			const auto out = l + 2 < layer_sizes.size()
+								 ? "x" + std::to_string(l + 1)
+								 : std::string{"out"};
+			for (std::size_t j = 0; j < layer_sizes[l + 1]; ++j) {
+				s << "\t{\n\t\t" << type << " o = 0;\n";
+				for (std::size_t i = 0; i < layer_sizes[l]; ++i) {
+					const auto w = (j * layer_sizes[l] + i) * 2;
+					s << "\t\to += " << in << "[" << i << "] * layer" << l
+					  << "[" << w << "] + layer" << l << "[" << w + 1
+					  << "];\n";
+				}
+				As::writers[l](s, is_float);
+				s << "\t\t" << out << "[" << j << "] = o;\n\t}\n";
+			}
+		}
+		s << "}\n\n"
+		  << "// compute result\n"
+		  << "constexpr std::array<" << type << ", out_size> evaluate(\n"
+		  << "\tconst std::array<" << type << ", in_size>& in) {\n"
+		  << "\tstd::array<" << type << ", out_size> out{};\n"
+		  << "\tevaluate(in.data(), out.data());\n"
+		  << "\treturn out;\n"
+		  << "}\n"
+		  << "}  // namespace " << name << "\n";
+	}
+
+	// write header computing this network to file @path@ (see above)
+	void save_header(const std::filesystem::path& path,
+					 std::string_view name) const {
+		std::ofstream f(path, std::ios::trunc);
+		save_header(f, name);
+		if (not f) {
+			throw std::runtime_error{"net::SimpleNet can't write header"};
+		}
+	}
+
+   private:
+	// neurons data
+	T* data;
+	// data is allocated by ActivatedSimpleNet
+	bool owner;
+	// first layer
+	layer_type layer;
+
+	// operator for restoring ActivatedSimpleNet from stream
+	template <typename Tchar>
+	friend std::basic_istream<Tchar>& operator>>(std::basic_istream<Tchar>& s,
+												 ActivatedSimpleNet& n) {
+		return s.read(reinterpret_cast<Tchar*>(n.data),
+					  ActivatedSimpleNet::data_size * sizeof(T));
+	}
+
+	// operator for saving ActivatedSimpleNet to stream
+	template <typename Tchar>
+	friend std::basic_ostream<Tchar>& operator<<(std::basic_ostream<Tchar>& s,
+												 const ActivatedSimpleNet& n) {
+		return s.write(reinterpret_cast<const Tchar*>(n.data),
+					   ActivatedSimpleNet::data_size * sizeof(T));
+	}
+};
+
+// activations<A, A, ...> of layers of neurons of network with sizes Ss
+template <typename A, std::size_t... Ss>
+using same_activations =
+	typename repeat_activation<A, std::max<std::size_t>(sizeof...(Ss), 1) -
+									  1>::type;
+
+// ActivatedSimpleNet with softsign activation of all layers
+template <typename T, std::size_t... Ss>
+using BasicSimpleNet =
+	ActivatedSimpleNet<T, same_activations<softsign, Ss...>, Ss...>;
+
+// SimpleNet storing data as store_type
+template <std::size_t... Ss>
+using SimpleNet = BasicSimpleNet<store_type, Ss...>;
+
+// class ActivatedDenseNet contain dense layers with one bias per neuron
+// every layer is row-major OUT x IN matrix of weights followed by OUT biases,
+// so network takes about half of data of ActivatedSimpleNet with same sizes
+// it can be used by Net instead of ActivatedSimpleNet
+// As is activations<...> with activation of each layer of neurons
+template <typename T, typename As, std::size_t... Ss>
+requires(sizeof...(Ss) >= 2 && As::size + 1 == sizeof...(Ss)) class
+	ActivatedDenseNet {
+   public:
+	// type of stored data
+	using storage_type = T;
+	// type of input, output and computed values
+	using value_type = compute_type_t<T>;
+	// type of first layer
+	using layer_type = DenseLayer<T, As, Ss...>;
+	// type of output data
+	using result_type = typename layer_type::result_type;
+	// type of input data
+	using feed_type = typename layer_type::feed_type;
+
+	// number of T what all layers are contain
+	constexpr static auto data_size = layer_type::data_size;
+	// sizes of layers
+	constexpr static std::array<std::size_t, sizeof...(Ss)> layer_sizes{Ss...};
+	// size of input data
+	constexpr static auto in_size = layer_type::in_size;
+	// size of output data
+	constexpr static auto out_size = layer_type::out_size;
+	// number of samples computed together by proccess_batch()
+	constexpr static std::size_t batch_size = 16;
+	// number of value_type needed by proccess_batch() for intermediate results
+	constexpr static std::size_t workspace_size =
+		batch_size * layer_type::buffer_size * 2;
+	// activations of layers
+	using activations_type = As;
+	// layout of data stored in checkpoint (matrix and biases of each layer)
+	// and code of activations
+	constexpr static std::uint32_t layout = 1 | As::code << 8;
+
+	// construct ActivatedDenseNet with allocated data
+	constexpr ActivatedDenseNet()
+		: data(new T[data_size]), owner(true), layer(data) {}
+
+	// construct ActivatedDenseNet over external storage of data_size values
+	// storage isn't owned by ActivatedDenseNet and should outlive it
+	explicit constexpr ActivatedDenseNet(T* storage)
+		: data(storage), owner(false), layer(data) {}
+
+	// copy constructor (copy always owns its data)
+	constexpr ActivatedDenseNet(const ActivatedDenseNet& other)
+		: ActivatedDenseNet() {
+		*this = other;
+	}
+
+	// move constructor
+	// takes data if other owns it, otherwise copies it (external storage
+	// stays with other)
+	// moved-from ActivatedDenseNet can only be assigned or destroyed
+	constexpr ActivatedDenseNet(ActivatedDenseNet&& other)
+		: data(other.owner ? other.data : new T[data_size]),
+		  owner(true),
+		  layer(data) {
+		if (other.owner) {
+			other.data = nullptr;
+		} else {
+			*this = other;
+		}
+	}
+
+	// deallocate store
+	constexpr ~ActivatedDenseNet() {
+		if (owner) {
+			delete[] data;
+		}
+	}
+
+	// compute result
+	constexpr result_type operator()(const feed_type& data) const {
+		return proccess(data);
+	}
+
+	// data of layers
+	std::span<const T, data_size> weights() const noexcept {
+		return std::span<const T, data_size>{data, data_size};
+	}
+
+	// copy data from other ActivatedDenseNet
+	// other can't be moved-from ActivatedDenseNet (it has no data)
+	constexpr ActivatedDenseNet& operator=(const ActivatedDenseNet& other) {
+		assert(other.data != nullptr);
+		if (data == nullptr) {
+			// moved-from ActivatedDenseNet
+			data = new T[data_size];
+			layer = layer_type(data);
+		}
+		std::memcpy(data, other.data, data_size * sizeof(T));
+
+		return *this;
+	}
+
+	// swap data with other ActivatedDenseNet if both own data, otherwise copy
+	// data (external storage is never exchanged)
+	constexpr ActivatedDenseNet& operator=(ActivatedDenseNet&& other) {
+		if (not(owner && other.owner)) {
+			return *this = other;
+		}
+
+		std::swap(data, other.data);
+		layer = layer_type(data);
+		other.layer = layer_type(other.data);
+
+		return *this;
+	}
+
+	// check DenseNets are equal
+	constexpr bool operator==(const ActivatedDenseNet& other) const {
+		return 0 == std::memcmp(data, other.data, data_size * sizeof(T));
+	}
+
+	// randomize network by generator of current thread
+	void rand() { rand(thread_random()); }
+
+	// randomize network by generator @gen@
+	template <typename URBG>
+	void rand(URBG& gen) {
+		rand_values(data, data_size, gen);
+	}
+
+	// write crossover of @a@ and @b@ into this network in place
+	// this network can be one of parents
+	// multi_point crossover uses @points@ random points
+	template <typename URBG>
+	ActivatedDenseNet& crossover(
+		const ActivatedDenseNet& a, const ActivatedDenseNet& b, URBG& gen,
+		crossover_type type = crossover_type::two_point,
+		std::size_t points = 4) {
+		net::crossover(data, a.data, b.data, data_size, type, points, gen);
+		return *this;
+	}
+
+	// mutate data at random index @count@ times by generator of current
+	// thread
+	ActivatedDenseNet& mutation(std::size_t count = 1) {
+		return mutation(count, thread_random());
+	}
+
+	// mutate data at random index @count@ times by generator @gen@
+	template <typename URBG>
+	ActivatedDenseNet& mutation(std::size_t count, URBG& gen) {
+		mutate_values(data, data_size, count, gen);
+		return *this;
+	}
+
+	// compute result
+	result_type proccess(const feed_type& data) const {
+		result_type o;
+		proccess(data.data(), o.data());
+		return o;
+	}
+
+	// compute result from in_size values into out_size values
+	// intermediate results are stored on stack, no memory is allocated
+	void proccess(const value_type* in, value_type* out) const {
+		std::array<value_type, layer_type::buffer_size> buf_a, buf_b;
+		layer.proccess(in, 1, out, buf_a.data(), buf_b.data());
+	}
+
+	// compute results for n samples
+	// in contains n rows of in_size values, out receives n rows of out_size
+	void proccess_batch(const value_type* in, std::size_t n,
+						value_type* out) const {
+		std::vector<value_type> workspace(workspace_size);
+		proccess_batch(in, n, out, workspace.data());
+	}
+
+	// compute results for n samples using workspace of workspace_size values
+	// for intermediate results, no memory is allocated
+	void proccess_batch(const value_type* in, std::size_t n, value_type* out,
+						value_type* workspace) const {
+		constexpr auto block = batch_size * layer_type::buffer_size;
+
+		for (std::size_t s = 0; s < n; s += batch_size) {
+			auto count = std::min(batch_size, n - s);
+			layer.proccess(in + s * in_size, count, out + s * out_size,
+						   workspace, workspace + block);
+		}
+	}
+
+	// compute results for each sample of in into out
+	void proccess_batch(std::span<const feed_type> in,
+						std::span<result_type> out) const {
+		if (in.size() != out.size()) {
+			throw std::invalid_argument{
+				"net::DenseNet::proccess_batch sizes of in and out differ"};
+		}
+		if (not in.empty()) {
+			proccess_batch(in.data()->data(), in.size(), out.data()->data());
+		}
+	}
+
+   private:
+	// data of layers
+	T* data;
+	// data is allocated by ActivatedDenseNet
+	bool owner;
+	// first layer
+	layer_type layer;
+
+	// operator for restoring ActivatedDenseNet from stream
+	template <typename Tchar>
+	friend std::basic_istream<Tchar>& operator>>(std::basic_istream<Tchar>& s,
+												 ActivatedDenseNet& n) {
+		return s.read(reinterpret_cast<Tchar*>(n.data),
+					  ActivatedDenseNet::data_size * sizeof(T));
+	}
+
+	// operator for saving ActivatedDenseNet to stream
+	template <typename Tchar>
+	friend std::basic_ostream<Tchar>& operator<<(std::basic_ostream<Tchar>& s,
+												 const ActivatedDenseNet& n) {
+		return s.write(reinterpret_cast<const Tchar*>(n.data),
+					   ActivatedDenseNet::data_size * sizeof(T));
+	}
+};
+
+// ActivatedDenseNet with softsign activation of all layers
+template <typename T, std::size_t... Ss>
+using BasicDenseNet =
+	ActivatedDenseNet<T, same_activations<softsign, Ss...>, Ss...>;
+
+// DenseNet storing data as store_type
+template <std::size_t... Ss>
+using DenseNet = BasicDenseNet<store_type, Ss...>;
+
+namespace {
+// piecewise linear approximation of sigmoid without division
+// segments are 1/16 wide on [0, 4), 1/2 on [4, 32), 8 on [32, 512),
+// error is below 0.002
+class SigmoidApprox {
+   public:
+	SigmoidApprox() {
+		std::size_t i = 0;
+		auto add = [&](float from, float to, float step) {
+			for (float x0 = from; x0 < to; x0 += step, ++i) {
+				float x1 = x0 + step;
+				slope[i] = (sigmoid(x1) - sigmoid(x0)) / step;
+				intercept[i] = sigmoid(x0) - slope[i] * x0;
+			}
+		};
+		add(0.f, 4.f, 1.f / 16);
+		add(4.f, 32.f, 1.f / 2);
+		add(32.f, 512.f, 8.f);
+	}
+
+	store_type operator()(store_type x) const {
+		auto a = abs(x);
+		std::size_t i;
+		if (a < 4.f) {
+			i = static_cast<std::size_t>(a * 16.f);
+		} else if (a < 32.f) {
+			i = 64 + static_cast<std::size_t>((a - 4.f) * 2.f);
+		} else if (a < 512.f) {
+			i = 120 + static_cast<std::size_t>((a - 32.f) * 0.125f);
+		} else {
+			return x > 0 ? limit : -limit;
+		}
+		auto y = slope[i] * a + intercept[i];
+		return x > 0 ? y : -y;
+	}
+
+   private:
+	constexpr static std::size_t segments = 64 + 56 + 60;
+	constexpr static store_type limit = 512.f / 513.f;
+
+	store_type slope[segments];
+	store_type intercept[segments];
+};
+
+// kernels of dot product of n (multiple of 16) unsigned 8 bit inputs and
+// signed 8 bit weights, all kernels give same results
+struct DotKernel {
+	using kernel_type = std::int32_t (*)(const std::uint8_t* x,
+										 const std::int8_t* w, std::size_t n);
+
+	static std::int32_t scalar(const std::uint8_t* x, const std::int8_t* w,
+							   std::size_t n) {
+		std::int32_t o = 0;
+		for (std::size_t i = 0; i < n; ++i) {
+			o += std::int32_t{x[i]} * std::int32_t{w[i]};
+		}
+		return o;
+	}
+
+#if NET_X86_SIMD
+	// values are widened to 16 bit and summed by vpmaddwd: vpmaddubsw would
+	// saturate sums of 255 * 127 pairs
+	__attribute__((target("avx2"))) static std::int32_t avx2(
+		const std::uint8_t* x, const std::int8_t* w, std::size_t n) {
+		__m256i acc = _mm256_setzero_si256();
+		for (std::size_t i = 0; i < n; i += 16) {
+			__m256i xv = _mm256_cvtepu8_epi16(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)));
+			__m256i wv = _mm256_cvtepi8_epi16(
+				_mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i)));
+			acc = _mm256_add_epi32(acc, _mm256_madd_epi16(xv, wv));
+		}
+		__m128i s = _mm_add_epi32(_mm256_castsi256_si128(acc),
+								  _mm256_extracti128_si256(acc, 1));
+		s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4e));
+		s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xb1));
+		return _mm_cvtsi128_si32(s);
+	}
+
+	// vpdpbusd sums products of unsigned and signed bytes without saturation
+	__attribute__((target("avx512f,avx512bw,avx512vnni"))) static std::int32_t
+	vnni(const std::uint8_t* x, const std::int8_t* w, std::size_t n) {
+		__m512i acc = _mm512_setzero_si512();
+		std::size_t i = 0;
+		for (; i + 64 <= n; i += 64) {
+			acc = _mm512_dpbusd_epi32(acc, _mm512_loadu_si512(x + i),
+									  _mm512_loadu_si512(w + i));
+		}
+		if (i < n) {
+			__mmask64 mask = ~__mmask64{0} >> (64 - (n - i));
+			acc = _mm512_dpbusd_epi32(acc, _mm512_maskz_loadu_epi8(mask, x + i),
+									  _mm512_maskz_loadu_epi8(mask, w + i));
+		}
+		// halves are extracted by zero masked forms, _mm512_reduce_add_epi32()
+		// and unmasked extracts of GCC headers pass undefined vector and warn
+		// by -Wuninitialized
+		__m256i h =
+			_mm256_add_epi32(_mm512_maskz_extracti64x4_epi64(0xff, acc, 0),
+							 _mm512_maskz_extracti64x4_epi64(0xff, acc, 1));
+		__m128i s = _mm_add_epi32(_mm256_castsi256_si128(h),
+								  _mm256_extracti128_si256(h, 1));
+		s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4e));
+		s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xb1));
+		return _mm_cvtsi128_si32(s);
+	}
+#endif
+
+	// return best kernel supported by current CPU
+	static kernel_type get() {
+#if NET_X86_SIMD
+		if (__builtin_cpu_supports("avx512vnni") &&
+			__builtin_cpu_supports("avx512bw"))
+			return vnni;
+		if (__builtin_cpu_supports("avx2"))
+			return avx2;
+#endif
+		return scalar;
+	}
+};
+}  // namespace
+
+// class QuantizedNet contain SimpleNet converted to 8 bit integers for fast
+// inference: weights are signed 8 bit with one scale per layer, inputs of
+// layers are unsigned 8 bit with scale and zero point calibrated on samples
+// biases of neuron are summed to one float
+template <std::size_t... Ss>
+class QuantizedNet {
+   public:
+	// type of converted network
+	using source_type = SimpleNet<Ss...>;
+	// type of output data
+	using result_type = typename source_type::result_type;
+	// type of input data
+	using feed_type = typename source_type::feed_type;
+
+	// size of input data
+	constexpr static auto in_size = source_type::in_size;
+	// size of output data
+	constexpr static auto out_size = source_type::out_size;
+	// number of layers
+	constexpr static auto layers_size = sizeof...(Ss) - 1;
+
+	// difference between results of QuantizedNet and source network
+	struct error_type {
+		store_type max;
+		store_type mean;
+	};
+
+	// convert network, ranges of layer inputs are taken from samples
+	QuantizedNet(const source_type& net, std::span<const feed_type> samples)
+		: kernel(DotKernel::get()) {
+		if (samples.empty()) {
+			throw std::invalid_argument{
+				"net::QuantizedNet needs samples for calibration"};
+		}
+
+		const auto& sizes = source_type::layer_sizes;
+		std::size_t w_size = 0, n_size = 0;
+		for (std::size_t l = 0; l < layers_size; ++l) {
+			auto& p = params[l];
+			p.in = sizes[l];
+			p.out = sizes[l + 1];
+			p.in_pad = (p.in + 15) / 16 * 16;
+			p.weights = w_size;
+			p.neurons = n_size;
+			w_size += p.in_pad * p.out;
+			n_size += p.out;
+		}
+		weights.resize(w_size);
+		bias.resize(n_size);
+		correction.resize(n_size);
+
+		calibrate(net, samples);
+
+		const auto* src = net.weights().data();
+		for (std::size_t l = 0; l < layers_size; ++l) {
+			auto& p = params[l];
+
+			store_type w_max = 0;
+			for (std::size_t i = 0; i < p.in * p.out; ++i) {
+				w_max = std::max(w_max, abs(src[i << 1]));
+			}
+			p.scale = w_max > 0 ? w_max / 127 : 1;
+
+			for (std::size_t j = 0; j < p.out; ++j) {
+				const auto* nd = src + j * p.in * 2;
+				auto* w = weights.data() + p.weights + j * p.in_pad;
+				store_type b = 0;
+				std::int32_t w_sum = 0;
+				for (std::size_t i = 0; i < p.in; ++i) {
+					w[i] = static_cast<std::int8_t>(
+						std::lround(nd[i << 1] / p.scale));
+					w_sum += w[i];
+					b += nd[(i << 1) + 1];
+				}
+				bias[p.neurons + j] = b;
+				correction[p.neurons + j] = w_sum * p.in_zero;
+			}
+			src += p.in * p.out * 2;
+		}
+	}
+
+	// compute result
+	result_type operator()(const feed_type& data) const {
+		result_type o;
+		proccess(data.data(), o.data());
+		return o;
+	}
+
+	// compute result from in_size values into out_size values
+	void proccess(const store_type* in, store_type* out) const {
+		alignas(64) std::uint8_t buf[2][buffer_size] = {};
+
+		quantize(params[0], in, buf[0]);
+		for (std::size_t l = 0; l < layers_size; ++l) {
+			const auto& p = params[l];
+			const auto* x = buf[l & 1];
+			auto* next = buf[(l + 1) & 1];
+			const bool last = l + 1 == layers_size;
+
+			for (std::size_t j = 0; j < p.out; ++j) {
+				auto acc = kernel(x, weights.data() + p.weights + j * p.in_pad,
+								  p.in_pad) -
+						   correction[p.neurons + j];
+				auto y =
+					approx(acc * p.in_scale * p.scale + bias[p.neurons + j]);
+				if (last) {
+					out[j] = y;
+				} else {
+					next[j] = quantize(params[l + 1], y);
+				}
+			}
+		}
+	}
+
+	// difference between results of source network and QuantizedNet
+	error_type error(const source_type& net,
+					 std::span<const feed_type> samples) const {
+		if (samples.empty()) {
+			throw std::invalid_argument{
+				"net::QuantizedNet::error needs samples"};
+		}
+
+		error_type o{0, 0};
+		for (const auto& s : samples) {
+			auto expected = net(s);
+			auto res = (*this)(s);
+			for (std::size_t i = 0; i < out_size; ++i) {
+				auto e = abs(expected[i] - res[i]);
+				o.max = std::max(o.max, e);
+				o.mean += e;
+			}
+		}
+		o.mean /= samples.size() * out_size;
+		return o;
+	}
+
+	// number of bytes used by parameters
+	std::size_t bytes() const noexcept {
+		return weights.size() * sizeof(std::int8_t) +
+			   bias.size() * sizeof(store_type) +
+			   correction.size() * sizeof(std::int32_t) + sizeof(params);
+	}
+
+   private:
+	// parameters of layer
+	struct layer_params {
+		std::size_t in, out, in_pad;
+		// offsets of layer in weights and in bias/correction
+		std::size_t weights, neurons;
+		// weight = scale * quantized weight
+		store_type scale;
+		// input = in_scale * (quantized input - in_zero)
+		store_type in_scale;
+		std::int32_t in_zero;
+	};
+
+	// size of buffer for quantized inputs of any layer
+	constexpr static std::size_t buffer_size =
+		(std::max({Ss...}) + 15) / 16 * 16;
+
+	// quantize input of layer
+	static std::uint8_t quantize(const layer_params& p, store_type x) {
+		auto q = std::lround(x / p.in_scale) + p.in_zero;
+		return static_cast<std::uint8_t>(std::clamp<long>(q, 0, 255));
+	}
+
+	// quantize p.in values
+	static void quantize(const layer_params& p, const store_type* in,
+						 std::uint8_t* out) {
+		for (std::size_t i = 0; i < p.in; ++i) {
+			out[i] = quantize(p, in[i]);
+		}
+	}
+
+	// compute ranges of inputs of layers on samples by float network
+	void calibrate(const source_type& net, std::span<const feed_type> samples) {
+		store_type lo[layers_size], hi[layers_size];
+		std::fill_n(lo, layers_size, 0.f);
+		std::fill_n(hi, layers_size, 0.f);
+
+		std::vector<store_type> x, y;
+		for (const auto& s : samples) {
+			x.assign(s.begin(), s.end());
+			const auto* src = net.weights().data();
+			for (std::size_t l = 0; l < layers_size; ++l) {
+				const auto& p = params[l];
+				for (auto v : x) {
+					lo[l] = std::min(lo[l], v);
+					hi[l] = std::max(hi[l], v);
+				}
+				y.resize(p.out);
+				for (std::size_t j = 0; j < p.out; ++j) {
+					store_type o = 0;
+					const auto* nd = src + j * p.in * 2;
+					for (std::size_t i = 0; i < p.in; ++i) {
+						o += x[i] * nd[i << 1] + nd[(i << 1) + 1];
+					}
+					y[j] = sigmoid(o);
+				}
+				src += p.in * p.out * 2;
+				std::swap(x, y);
+			}
+		}
+
+		for (std::size_t l = 0; l < layers_size; ++l) {
+			auto& p = params[l];
+			auto range = hi[l] - lo[l];
+			p.in_scale = range > 0 ? range / 255 : 1;
+			p.in_zero =
+				static_cast<std::int32_t>(std::lround(-lo[l] / p.in_scale));
+		}
+	}
+
+	layer_params params[layers_size];
+	std::vector<std::int8_t> weights;
+	std::vector<store_type> bias;
+	// zero point of inputs multiplied by sum of quantized weights of neuron
+	std::vector<std::int32_t> correction;
+	DotKernel::kernel_type kernel;
+	SigmoidApprox approx;
+};
+
+// class ActivatedSparseNet contain ActivatedSimpleNet of floats pruned by
+// magnitude of weights for fast inference: weights below threshold are
+// removed and each layer is stored as compressed sparse rows (columns and
+// weights of every neuron), biases of neuron are summed to one value
+// As are activations of layers (same as of source network)
+// results differ from source network by pruned weights and by order of sums,
+// error() reports the difference
+template <typename As, std::size_t... Ss>
+requires(sizeof...(Ss) >= 2 && As::size + 1 == sizeof...(Ss)) class
+	ActivatedSparseNet {
+   public:
+	// type of pruned network
+	using source_type = ActivatedSimpleNet<store_type, As, Ss...>;
+	// activations of layers
+	using activations_type = As;
+	// type of output data
+	using result_type = typename source_type::result_type;
+	// type of input data
+	using feed_type = typename source_type::feed_type;
+	// type of stored indexes of inputs
+	using index_type = std::conditional_t<(std::max({Ss...}) <= 0xffff),
+										  std::uint16_t, std::uint32_t>;
+
+	// size of input data
+	constexpr static auto in_size = source_type::in_size;
+	// size of output data
+	constexpr static auto out_size = source_type::out_size;
+	// number of layers
+	constexpr static auto layers_size = sizeof...(Ss) - 1;
+	// number of neurons
+	constexpr static auto neurons_size = (Ss + ...) - in_size;
+	// number of weights of source network
+	constexpr static auto weights_size = source_type::data_size / 2;
+	// size of buffer for results of any layer
+	constexpr static std::size_t buffer_size = std::max({Ss...});
+	// number of samples computed together by proccess_batch()
+	constexpr static std::size_t batch_size = 16;
+	// number of store_type needed by proccess_batch() for intermediate results
+	constexpr static std::size_t workspace_size = batch_size * buffer_size * 2;
+
+	// difference between results of SparseNet and source network
+	struct error_type {
+		store_type max;
+		store_type mean;
+	};
+
+	// construct empty network (every neuron computes its bias), it can be
+	// restored by operator>>
+	ActivatedSparseNet() : row_begin(neurons_size + 1), bias(neurons_size) {}
+
+	// prune weights of network which magnitude is below @threshold@
+	ActivatedSparseNet(const source_type& net, store_type threshold)
+		: ActivatedSparseNet() {
+		const auto* src = net.weights().data();
+		std::size_t neuron = 0;
+		for (std::size_t l = 0; l < layers_size; ++l) {
+			const auto in = source_type::layer_sizes[l];
+			const auto out = source_type::layer_sizes[l + 1];
+			for (std::size_t j = 0; j < out; ++j, ++neuron) {
+				const auto* nd = src + j * in * 2;
+				store_type b = 0;
+				for (std::size_t i = 0; i < in; ++i) {
+					b += nd[(i << 1) + 1];
+					if (abs(nd[i << 1]) < threshold)
+						continue;
+					columns.push_back(static_cast<index_type>(i));
+					values.push_back(nd[i << 1]);
+				}
+				bias[neuron] = b;
+				row_begin[neuron + 1] = columns.size();
+			}
+			src += in * out * 2;
+		}
+	}
+
+	// threshold removing @sparsity@ part (in [0, 1]) of weights of network
+	static store_type threshold_for(const source_type& net, double sparsity) {
+		if (not(sparsity >= 0 && sparsity <= 1)) {
+			throw std::invalid_argument{
+				"net::SparseNet sparsity should be in [0, 1]"};
+		}
+		std::vector<store_type> magnitudes(weights_size);
+		for (std::size_t i = 0; i < weights_size; ++i) {
+			magnitudes[i] = abs(net.weights()[i << 1]);
+		}
+		const auto k =
+			static_cast<std::size_t>(std::llround(sparsity * weights_size));
+		if (k == weights_size)
+			return std::numeric_limits<store_type>::infinity();
+		std::nth_element(std::begin(magnitudes), std::begin(magnitudes) + k,
+						 std::end(magnitudes));
+		return magnitudes[k];
+	}
+
+	// compute result
+	result_type operator()(const feed_type& data) const {
+		result_type o;
+		proccess(data.data(), o.data());
+		return o;
+	}
+
+	// compute result from in_size values into out_size values
+	void proccess(const store_type* in, store_type* out) const {
+		std::array<store_type, buffer_size> buf[2];
+		const auto* x = in;
+		std::size_t neuron = 0;
+		for_layers([&](auto layer) {
+			constexpr std::size_t l = decltype(layer)::value;
+			using A = typename As::template layer<l>;
+			const auto size = source_type::layer_sizes[l + 1];
+			auto* y = l + 1 == layers_size ? out : buf[l & 1].data();
+			for (std::size_t j = 0; j < size; ++j, ++neuron) {
+				store_type o = bias[neuron];
+				for (auto p = row_begin[neuron]; p < row_begin[neuron + 1];
+					 ++p) {
+					o += values[p] * x[columns[p]];
+				}
+				A::apply(o);
+				y[j] = o;
+			}
+			x = y;
+		});
+	}
+
+	// compute results for n samples
+	// in contains n rows of in_size values, out receives n rows of out_size
+	// samples are computed by blocks of batch_size, so each kept weight is
+	// loaded once per block, results are same as of proccess()
+	void proccess_batch(const store_type* in, std::size_t n,
+						store_type* out) const {
+		std::vector<store_type> workspace(workspace_size);
+		proccess_batch(in, n, out, workspace.data());
+	}
+
+	// compute results for n samples using workspace of workspace_size values
+	// for intermediate results, no memory is allocated
+	void proccess_batch(const store_type* in, std::size_t n, store_type* out,
+						store_type* workspace) const {
+		// values of block are stored by inputs: x[input * batch_size + sample]
+		constexpr auto B = batch_size;
+		for (std::size_t s0 = 0; s0 < n; s0 += B) {
+			const auto count = std::min(B, n - s0);
+			auto* x = workspace;
+			auto* y = workspace + buffer_size * B;
+			for (std::size_t s = 0; s < B; ++s) {
+				for (std::size_t i = 0; i < in_size; ++i) {
+					x[i * B + s] = s < count ? in[(s0 + s) * in_size + i] : 0;
+				}
+			}
+
+			std::size_t neuron = 0;
+			for_layers([&](auto layer) {
+				constexpr std::size_t l = decltype(layer)::value;
+				using A = typename As::template layer<l>;
+				const auto size = source_type::layer_sizes[l + 1];
+				for (std::size_t j = 0; j < size; ++j, ++neuron) {
+					store_type o[B];
+					std::fill_n(o, B, bias[neuron]);
+					for (auto p = row_begin[neuron]; p < row_begin[neuron + 1];
+						 ++p) {
+						const auto w = values[p];
+						const auto* xc = x + columns[p] * B;
+						for (std::size_t s = 0; s < B; ++s) {
+							o[s] += w * xc[s];
+						}
+					}
+					for (std::size_t s = 0; s < B; ++s) {
+						A::apply(o[s]);
+						y[j * B + s] = o[s];
+					}
+				}
+				std::swap(x, y);
+			});
+
+			for (std::size_t s = 0; s < count; ++s) {
+				for (std::size_t j = 0; j < out_size; ++j) {
+					out[(s0 + s) * out_size + j] = x[j * B + s];
+				}
+			}
+		}
+	}
+
+	// compute results for each sample of in into out
+	void proccess_batch(std::span<const feed_type> in,
+						std::span<result_type> out) const {
+		if (in.size() != out.size()) {
+			throw std::invalid_argument{
+				"net::SparseNet::proccess_batch sizes of in and out differ"};
+		}
+		if (not in.empty()) {
+			proccess_batch(in.data()->data(), in.size(), out.data()->data());
+		}
+	}
+
+	// difference between results of source network and SparseNet
+	error_type error(const source_type& net,
+					 std::span<const feed_type> samples) const {
+		if (samples.empty()) {
+			throw std::invalid_argument{"net::SparseNet::error needs samples"};
+		}
+
+		error_type o{0, 0};
+		for (const auto& s : samples) {
+			auto expected = net(s);
+			auto res = (*this)(s);
+			for (std::size_t i = 0; i < out_size; ++i) {
+				auto e = abs(expected[i] - res[i]);
+				o.max = std::max(o.max, e);
+				o.mean += e;
+			}
+		}
+		o.mean /= samples.size() * out_size;
+		return o;
+	}
 
-	// wrapper for mutation()
-	SimpleNet& operator++() { return mutation(); }
+	// number of kept weights
+	std::size_t nonzeros() const noexcept { return values.size(); }
 
-	// wrapper for mutation()
-	SimpleNet operator++(int z) {
-		SimpleNet o{*this};
-		mutation(z ? z : 1);
-		return o;
+	// part of removed weights
+	double sparsity() const noexcept {
+		return 1. - double(values.size()) / weights_size;
+	}
+
+	// number of bytes used by parameters (and by serialized network)
+	std::size_t bytes() const noexcept {
+		return sizeof(std::uint32_t) + neurons_size * sizeof(index_type) +
+			   values.size() * (sizeof(index_type) + sizeof(store_type)) +
+			   bias.size() * sizeof(store_type);
 	}
 
-	// randomize network
-	void rand() {
-		std::random_device rd;
-		std::uniform_real_distribution<store_type> rand;
-		for (std::size_t i = 0; i < data_size; ++i) {
-			data[i] = rand(rd);
+   private:
+	// call fn(std::integral_constant<std::size_t, L>) for each layer L
+	template <typename Fn>
+	static void for_layers(Fn&& fn) {
+		[&fn]<std::size_t... L>(std::index_sequence<L...>) {
+			(fn(std::integral_constant<std::size_t, L>{}), ...);
+		}(std::make_index_sequence<layers_size>{});
+	}
+
+	// start of weights of each neuron in columns and values (and their end)
+	std::vector<std::uint32_t> row_begin;
+	// index of input and weight of kept weights
+	std::vector<index_type> columns;
+	std::vector<store_type> values;
+	// sum of biases of each neuron
+	std::vector<store_type> bias;
+
+	// operator for restoring SparseNet from stream
+	// format: number of kept weights, number of kept weights of each neuron,
+	// their indexes of inputs, their values and biases of neurons
+	// failbit is set if data is inconsistent with sizes of layers
+	template <typename Tchar>
+	friend std::basic_istream<Tchar>& operator>>(std::basic_istream<Tchar>& s,
+												 ActivatedSparseNet& n) {
+		auto read = [&s](auto* data, std::size_t count) {
+			s.read(reinterpret_cast<Tchar*>(data),
+				   count * sizeof(*data) / sizeof(Tchar));
+		};
+
+		std::uint32_t count = 0;
+		read(&count, 1);
+		if (not s || count > weights_size) {
+			s.setstate(std::ios::failbit);
+			return s;
 		}
+
+		ActivatedSparseNet o;
+		std::vector<index_type> lengths(neurons_size);
+		o.columns.resize(count);
+		o.values.resize(count);
+		read(lengths.data(), lengths.size());
+		read(o.columns.data(), count);
+		read(o.values.data(), count);
+		read(o.bias.data(), o.bias.size());
+		if (not s)
+			return s;
+
+		// every neuron has at most one weight for each input in order
+		std::size_t neuron = 0;
+		for (std::size_t l = 0; l < layers_size; ++l) {
+			const auto in = source_type::layer_sizes[l];
+			for (std::size_t j = 0; j < source_type::layer_sizes[l + 1];
+				 ++j, ++neuron) {
+				const auto b = o.row_begin[neuron];
+				const std::size_t e = b + lengths[neuron];
+				if (e > count) {
+					s.setstate(std::ios::failbit);
+					return s;
+				}
+				for (auto p = b; p < e; ++p) {
+					if (o.columns[p] >= in ||
+						(p > b && o.columns[p] <= o.columns[p - 1])) {
+						s.setstate(std::ios::failbit);
+						return s;
+					}
+				}
+				o.row_begin[neuron + 1] = e;
+			}
+		}
+		if (o.row_begin.back() != count) {
+			s.setstate(std::ios::failbit);
+			return s;
+		}
+
+		n = std::move(o);
+		return s;
 	}
 
-	// merge networks by random indexes
-	SimpleNet merge(const SimpleNet& other) const {
-		SimpleNet o(*this);
+	// operator for saving SparseNet to stream
+	template <typename Tchar>
+	friend std::basic_ostream<Tchar>& operator<<(std::basic_ostream<Tchar>& s,
+												 const ActivatedSparseNet& n) {
+		auto write = [&s](const auto* data, std::size_t count) {
+			s.write(reinterpret_cast<const Tchar*>(data),
+					count * sizeof(*data) / sizeof(Tchar));
+		};
 
-		std::random_device rd;
-		std::uniform_int_distribution<std::size_t> rand_index(
-			0, layer_type::data_size - 1);
+		const auto count = static_cast<std::uint32_t>(n.values.size());
+		std::vector<index_type> lengths(neurons_size);
+		for (std::size_t i = 0; i < neurons_size; ++i) {
+			lengths[i] =
+				static_cast<index_type>(n.row_begin[i + 1] - n.row_begin[i]);
+		}
+		write(&count, 1);
+		write(lengths.data(), lengths.size());
+		write(n.columns.data(), n.columns.size());
+		write(n.values.data(), n.values.size());
+		write(n.bias.data(), n.bias.size());
+		return s;
+	}
+};
 
-		auto r = rand_index(rd);
-		auto l = rand_index(rd);
-		if (l > r)
-			std::swap(l, r);
+// SparseNet is pruned SimpleNet (softsign in every layer)
+template <std::size_t... Ss>
+using SparseNet = ActivatedSparseNet<same_activations<softsign, Ss...>, Ss...>;
 
-		std::memcpy(o.data + 0, data + 0, l * sizeof(store_type));
-		std::memcpy(o.data + r, data + r,
-					(layer_type::data_size - r) * sizeof(store_type));
-		std::memcpy(o.data + l, other.data + l, (r - l) * sizeof(store_type));
+// class ThreadPool contain persistent threads computing parallel loops
+// thread calling parallel_for() computes its part of loop too
+class ThreadPool {
+   public:
+	// construct ThreadPool computing by @threads@ threads (including caller)
+	explicit ThreadPool(
+		std::size_t threads = std::thread::hardware_concurrency()) {
+		threads = std::max<std::size_t>(threads, 1);
+		workers.reserve(threads - 1);
+		for (std::size_t i = 1; i < threads; ++i) {
+			workers.emplace_back([this, i] { work(i); });
+		}
+	}
 
-		return o;
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// stop and join threads
+	~ThreadPool() {
+		{
+			std::lock_guard lock{mutex};
+			stop = true;
+		}
+		start.notify_all();
 	}
 
-	// mutate stored neurons data at random index @count@ times
-	SimpleNet& mutation(std::size_t count = 1) {
-		std::random_device rd;
-		std::uniform_int_distribution<std::size_t> rand_index(
-			0, layer_type::data_size - 1);
-		std::uniform_real_distribution<store_type> rand_mutation(-mutk, mutk);
+	// number of threads computing loops (including caller)
+	std::size_t size() const noexcept { return workers.size() + 1; }
+
+	// call fn(begin, end, thread) for chunks of [0, n) of @chunk@ indexes
+	// thread is index of thread in [0, size()), 0 is caller
+	// returns when all chunks are computed
+	// if fn throws, chunks which aren't started are skipped and first exception
+	// is rethrown when all threads leave fn
+	// should not be called concurrently or from fn
+	template <typename Fn>
+	void parallel_for(std::size_t n, std::size_t chunk, Fn&& fn) {
+		chunk = std::max<std::size_t>(chunk, 1);
+		if (workers.empty() || n <= chunk) {
+			for (std::size_t b = 0; b < n; b += chunk) {
+				fn(b, std::min(b + chunk, n), std::size_t{0});
+			}
+			return;
+		}
+
+		{
+			std::lock_guard lock{mutex};
+			job = [](void* ctx, std::size_t b, std::size_t e, std::size_t t) {
+				(*static_cast<std::remove_reference_t<Fn>*>(ctx))(b, e, t);
+			};
+			job_ctx = const_cast<void*>(static_cast<const void*>(&fn));
+			job_size = n;
+			job_chunk = chunk;
+			next_index = 0;
+			active = workers.size();
+			++generation;
+		}
+		start.notify_all();
+
+		run(0);
+
+		std::unique_lock lock{mutex};
+		done.wait(lock, [this] { return active == 0; });
+		if (error)
+			std::rethrow_exception(std::exchange(error, nullptr));
+	}
+
+   private:
+	// take chunks of current job until all of them are taken
+	void run(std::size_t thread) {
+		for (;;) {
+			auto b = next_index.fetch_add(job_chunk);
+			if (b >= job_size)
+				break;
+			try {
+				job(job_ctx, b, std::min(b + job_chunk, job_size), thread);
+			} catch (...) {
+				std::lock_guard lock{mutex};
+				if (!error)
+					error = std::current_exception();
+				next_index = job_size;
+			}
+		}
+	}
+
+	// loop of worker thread
+	void work(std::size_t thread) {
+		std::size_t seen = 0;
+		std::unique_lock lock{mutex};
+		for (;;) {
+			start.wait(lock, [&] { return stop || generation != seen; });
+			if (stop)
+				return;
+			seen = generation;
+
+			lock.unlock();
+			run(thread);
+			lock.lock();
+
+			if (--active == 0)
+				done.notify_one();
+		}
+	}
+
+	std::mutex mutex;
+	std::condition_variable start;
+	std::condition_variable done;
+	bool stop = false;
+	// number of started jobs
+	std::size_t generation = 0;
+	// number of workers computing current job
+	std::size_t active = 0;
+
+	// current job
+	void (*job)(void*, std::size_t, std::size_t, std::size_t) = nullptr;
+	void* job_ctx = nullptr;
+	std::size_t job_size = 0;
+	std::size_t job_chunk = 1;
+	std::atomic<std::size_t> next_index = 0;
+	// first exception thrown by fn of current job
+	std::exception_ptr error;
+
+	// destroyed (joined) first
+	std::vector<std::jthread> workers;
+};
+
+#if NET_HAS_PROCESS
+// class ProcessPool contain forked worker processes counting score of networks
+// for scorers which can't be called from several threads (e.g. not thread-safe
+// simulation), each worker calls fn(network) for networks sent to it
+// networks are sent by batches through Unix domain sockets (serialized by
+// stream operators), every worker has several batches in flight, batches of
+// crashed worker are sent again to new worker
+// workers are forked from caller (also when crashed worker is replaced), so
+// fn shouldn't depend on threads or locks of caller
+template <typename net_type,
+		  typename score_type = typename net_type::value_type>
+class ProcessPool {
+   public:
+	// function counting score of network in worker process
+	using function_type = std::function<score_type(const net_type&)>;
+
+	// number of times batch is sent before score() gives up
+	constexpr static std::size_t max_attempts = 3;
+
+	// fork @workers@ processes calling @fn@ for networks sent by batches of
+	// @batch@ networks, @in_flight@ batches are sent to each worker without
+	// waiting for results
+	ProcessPool(std::size_t workers, function_type fn, std::size_t batch = 16,
+				std::size_t in_flight = 2)
+		: fn(std::move(fn)),
+		  batch(std::max<std::size_t>(batch, 1)),
+		  in_flight(std::max<std::size_t>(in_flight, 1)),
+		  procs(std::max<std::size_t>(workers, 1)) {
+		for (auto& p : procs) {
+			spawn(p);
+		}
+	}
 
+	ProcessPool(const ProcessPool&) = delete;
+	ProcessPool& operator=(const ProcessPool&) = delete;
+
+	// close sockets (workers exit) and wait for workers
+	~ProcessPool() {
+		for (auto& p : procs) {
+			stop(p);
+		}
+	}
+
+	// number of worker processes
+	std::size_t size() const noexcept { return procs.size(); }
+
+	// number of workers forked again after crash
+	std::size_t restarts() const noexcept { return restarted; }
+
+	// count scores of @nets@ by workers, score of nets[i] is stored to
+	// out[i]
+	// throw std::runtime_error if batch crashes max_attempts workers
+	void score(std::span<const net_type* const> nets,
+			   std::span<score_type> out) {
+		const auto batches = (nets.size() + batch - 1) / batch;
+		std::deque<std::size_t> todo;
+		std::vector<std::size_t> attempts(batches);
+		for (std::size_t b = 0; b < batches; ++b) {
+			todo.push_back(b);
+		}
+
+		std::vector<pollfd> fds(procs.size());
+		for (std::size_t done = 0; done < batches;) {
+			for (std::size_t w = 0; w < procs.size(); ++w) {
+				auto& p = procs[w];
+				while (p.sent.size() < in_flight && not todo.empty()) {
+					const auto b = todo.front();
+					todo.pop_front();
+					if (++attempts[b] > max_attempts) {
+						// answers of batches in flight are dropped
+						for (auto& other : procs) {
+							stop(other);
+							spawn(other);
+						}
+						throw std::runtime_error{
+							"net::ProcessPool batch crashed workers"};
+					}
+					append(p, b, nets);
+				}
+				fds[w] = {p.fd, short(POLLIN | (p.out.empty() ? 0 : POLLOUT)),
+						  0};
+			}
+
+			if (::poll(fds.data(), fds.size(), -1) < 0) {
+				if (errno == EINTR)
+					continue;
+				throw std::runtime_error{"net::ProcessPool poll failed"};
+			}
+
+			for (std::size_t w = 0; w < procs.size(); ++w) {
+				auto& p = procs[w];
+				const auto ev = fds[w].revents;
+				bool alive = true;
+				if (ev & POLLOUT)
+					alive = flush(p);
+				if (alive && (ev & (POLLIN | POLLHUP | POLLERR)))
+					alive = receive(p, out, done);
+				if (alive)
+					continue;
+
+				// worker crashed, its batches are sent again
+				for (auto b : p.sent) {
+					todo.push_front(b);
+				}
+				stop(p);
+				spawn(p);
+				++restarted;
+			}
+		}
+	}
+
+   private:
+	// header of batch sent to worker and of its scores
+	struct message_header {
+		std::uint64_t batch;
+		std::uint64_t count;
+	};
+
+	// worker process and its socket
+	struct process {
+		pid_t pid = -1;
+		int fd = -1;
+		// batches sent to worker
+		std::deque<std::size_t> sent;
+		// data not written to socket yet and data not parsed yet
+		std::vector<char> out;
+		std::vector<char> in;
+	};
+
+	// serialize batch @b@ of @nets@ and append it to output of @p@
+	void append(process& p, std::size_t b,
+				std::span<const net_type* const> nets) {
+		const auto first = b * batch;
+		const auto count = std::min(batch, nets.size() - first);
+		std::ostringstream s;
+		message_header header{b, count};
+		s.write(reinterpret_cast<const char*>(&header), sizeof(header));
 		for (std::size_t i = 0; i < count; ++i) {
-			auto mut_idx = rand_index(rd);
-			data[mut_idx] += rand_mutation(rd);
+			s << *nets[first + i];
 		}
+		auto data = std::move(s).str();
+		p.out.insert(std::end(p.out), std::begin(data), std::end(data));
+		p.sent.push_back(b);
+	}
 
-		return *this;
+	// write output of @p@ as far as socket accepts it
+	// return false if worker is dead
+	static bool flush(process& p) {
+		while (not p.out.empty()) {
+			auto n = ::send(p.fd, p.out.data(), p.out.size(),
+							MSG_NOSIGNAL | MSG_DONTWAIT);
+			if (n < 0) {
+				if (errno == EINTR)
+					continue;
+				return errno == EAGAIN || errno == EWOULDBLOCK;
+			}
+			p.out.erase(std::begin(p.out), std::begin(p.out) + n);
+		}
+		return true;
 	}
 
-	// compute result
-	result_type proccess(const feed_type& data) const {
-		auto data_copy{data};
-		return layer->proccess(data_copy);
+	// read scores sent by @p@ to out, count received batches in @done@
+	// return false if worker is dead
+	bool receive(process& p, std::span<score_type> out, std::size_t& done) {
+		char buffer[4096];
+		auto n = ::recv(p.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+		if (n < 0)
+			return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+		if (n == 0)
+			return false;
+		p.in.insert(std::end(p.in), buffer, buffer + n);
+
+		for (;;) {
+			message_header header;
+			if (p.in.size() < sizeof(header))
+				break;
+			std::memcpy(&header, p.in.data(), sizeof(header));
+			// worker answers batches in order, other answer means broken
+			// worker (it's handled as crashed one)
+			if (p.sent.empty() || header.batch != p.sent.front() ||
+				header.count !=
+					std::min(batch, out.size() - header.batch * batch))
+				return false;
+			const auto size =
+				sizeof(header) + header.count * sizeof(score_type);
+			if (p.in.size() < size)
+				break;
+			std::memcpy(out.data() + header.batch * batch,
+						p.in.data() + sizeof(header),
+						header.count * sizeof(score_type));
+			p.in.erase(std::begin(p.in), std::begin(p.in) + size);
+			p.sent.pop_front();
+			++done;
+		}
+		return true;
+	}
+
+	// fork worker of @p@
+	void spawn(process& p) {
+		int fds[2];
+		if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+			throw std::runtime_error{"net::ProcessPool can't create socket"};
+		}
+		auto pid = ::fork();
+		if (pid < 0) {
+			::close(fds[0]);
+			::close(fds[1]);
+			throw std::runtime_error{"net::ProcessPool can't fork"};
+		}
+		if (pid == 0) {
+			::close(fds[0]);
+			// sockets of other workers are closed, so they see end of data
+			// when caller closes them
+			for (auto& other : procs) {
+				if (other.fd >= 0)
+					::close(other.fd);
+			}
+			// nothing of caller is destroyed in worker
+			::_exit(work(fds[1]));
+		}
+		::close(fds[1]);
+		p = process{};
+		p.pid = pid;
+		p.fd = fds[0];
+	}
+
+	// close socket of @p@ and wait for its worker
+	// socket is shut down first, workers of other pools forked later hold
+	// copies of it, so closing wouldn't end data for worker of @p@
+	static void stop(process& p) {
+		if (p.fd < 0)
+			return;
+		::shutdown(p.fd, SHUT_RDWR);
+		::close(p.fd);
+		p.fd = -1;
+		while (::waitpid(p.pid, nullptr, 0) < 0 && errno == EINTR) {
+		}
+	}
+
+	// read exactly @size@ bytes, return false at end of data
+	static bool read_all(int fd, char* data, std::size_t size) {
+		while (size) {
+			auto n = ::read(fd, data, size);
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n <= 0)
+				return false;
+			data += n;
+			size -= n;
+		}
+		return true;
+	}
+
+	// loop of worker: answer batches until socket is closed
+	int work(int fd) {
+		constexpr auto net_size = net_type::data_size *
+								  sizeof(typename net_type::storage_type);
+		net_type n;
+		std::string data;
+		std::vector<char> answer;
+		try {
+			for (;;) {
+				message_header header;
+				if (not read_all(fd, reinterpret_cast<char*>(&header),
+								 sizeof(header)))
+					return 0;
+				data.resize(header.count * net_size);
+				if (not read_all(fd, data.data(), data.size()))
+					return 1;
+
+				answer.resize(sizeof(header) +
+							  header.count * sizeof(score_type));
+				std::memcpy(answer.data(), &header, sizeof(header));
+				std::istringstream s{std::move(data)};
+				for (std::size_t i = 0; i < header.count; ++i) {
+					s >> n;
+					const score_type score = fn(n);
+					std::memcpy(answer.data() + sizeof(header) +
+									i * sizeof(score_type),
+								&score, sizeof(score));
+				}
+				data = std::move(s).str();
+
+				for (std::size_t w = 0; w < answer.size();) {
+					auto k = ::send(fd, answer.data() + w, answer.size() - w,
+									MSG_NOSIGNAL);
+					if (k < 0 && errno == EINTR)
+						continue;
+					if (k <= 0)
+						return 1;
+					w += k;
+				}
+			}
+		} catch (...) {
+			return 1;
+		}
+	}
+
+	function_type fn;
+	const std::size_t batch;
+	const std::size_t in_flight;
+	std::vector<process> procs;
+	std::size_t restarted = 0;
+};
+#endif
+
+// class Dataset contain samples mapped from file
+// file has header, IN values of every sample and then LABELS values of every
+// sample (e.g. expected results), sections are aligned to page
+// samples are handed out by blocks of consecutive samples without copying
+// values are stored as T (network computing them should have same value_type)
+template <std::size_t IN, std::size_t LABELS = 0, typename T = store_type>
+class Dataset {
+	static_assert(std::is_floating_point_v<T>,
+				  "samples are stored as computed values");
+
+   public:
+	// type of input data
+	using feed_type = array<T, IN>;
+
+	// size of input data
+	constexpr static auto in_size = IN;
+	// number of labels of sample
+	constexpr static auto labels_size = LABELS;
+
+	// block of samples
+	struct view_type {
+		// input data of samples
+		std::span<const feed_type> inputs;
+		// labels of samples (LABELS values for each sample)
+		const T* labels_data;
+		// index of first sample of block in dataset
+		std::size_t first;
+
+		// number of samples
+		std::size_t size() const noexcept { return inputs.size(); }
+
+		// labels of sample @i@ of block
+		std::span<const T, LABELS> labels(std::size_t i) const {
+			return std::span<const T, LABELS>{
+				labels_data + i * LABELS, LABELS};
+		}
+	};
+
+	// map file created by write() or convert_csv()
+	// samples are handed out by blocks of @block_size_@ samples
+	explicit Dataset(const std::filesystem::path& path,
+					 std::size_t block_size_ = 4096)
+		: block_size(std::max<std::size_t>(block_size_, 1)) {
+		map(path);
+
+		// mapping is released if file is rejected (destructor isn't called)
+		try {
+			header_type header;
+			if (file_size < sizeof(header))
+				fail("is too small");
+			std::memcpy(&header, base, sizeof(header));
+
+			if (std::memcmp(header.magic, magic, sizeof(header.magic)))
+				fail("has wrong magic");
+			if (header.version != version || header.endian != endian)
+				fail("has unsupported version or byte order");
+			if (header.store_size != sizeof(T) ||
+				header.in_size != IN || header.labels_size != LABELS)
+				fail("has other types of samples");
+
+			if (header.inputs_offset % page != 0 ||
+				header.labels_offset % page != 0 ||
+				!fits_in(file_size, header.inputs_offset, header.samples,
+						 sizeof(feed_type)) ||
+				!fits_in(file_size, header.labels_offset, header.samples,
+						 LABELS * sizeof(T)))
+				fail("is truncated");
+			samples = header.samples;
+
+			inputs = reinterpret_cast<const feed_type*>(
+				static_cast<const char*>(base) + header.inputs_offset);
+			labels = reinterpret_cast<const T*>(
+				static_cast<const char*>(base) + header.labels_offset);
+
+			order.resize(blocks());
+			for (std::size_t i = 0; i < order.size(); ++i) {
+				order[i] = i;
+			}
+		} catch (...) {
+			unmap();
+			throw;
+		}
+	}
+
+	Dataset(const Dataset&) = delete;
+	Dataset& operator=(const Dataset&) = delete;
+
+	~Dataset() { unmap(); }
+
+	// number of samples
+	std::size_t size() const noexcept { return samples; }
+
+	// number of blocks
+	std::size_t blocks() const noexcept {
+		return (samples + block_size - 1) / block_size;
+	}
+
+	// all samples
+	view_type all() const { return view(0, samples); }
+
+	// block @i@ of dataset, next block is prefetched while this one is used
+	view_type block(std::size_t i) const {
+		prefetch(i + 1);
+		return view(i * block_size, block_size);
+	}
+
+	// shuffle order of blocks returned by minibatch()
+	template <typename URBG>
+	void shuffle(URBG& gen) {
+		std::shuffle(order.begin(), order.end(), gen);
+	}
+
+	// block @i@ in shuffled order, next minibatch is prefetched
+	// samples inside block keep order of file, shuffle file once when
+	// converting it if samples should be mixed too
+	view_type minibatch(std::size_t i) const {
+		if (i + 1 < order.size())
+			prefetch(order[i + 1]);
+		return view(order[i] * block_size, block_size);
+	}
+
+	// write samples to file readable by Dataset
+	// labels contain LABELS values for each sample
+	static void write(const std::filesystem::path& path,
+					  std::span<const feed_type> in,
+					  std::span<const T> labels_) {
+		if (labels_.size() != in.size() * LABELS) {
+			throw std::invalid_argument{
+				"net::Dataset::write wrong number of labels"};
+		}
+		std::ofstream f(path, std::ios::binary | std::ios::trunc);
+		write_header(f, in.size());
+		f.write(reinterpret_cast<const char*>(in.data()),
+				in.size() * sizeof(feed_type));
+		pad(f);
+		f.write(reinterpret_cast<const char*>(labels_.data()),
+				labels_.size() * sizeof(T));
+		if (not f)
+			fail("can't be written");
+	}
+
+	// convert CSV file of IN + LABELS numbers per line to file readable by
+	// Dataset; inputs are streamed, labels are kept in memory until end
+	static void convert_csv(const std::filesystem::path& csv,
+							const std::filesystem::path& path) {
+		std::ifstream in(csv);
+		std::ofstream f(path, std::ios::binary | std::ios::trunc);
+		if (not in)
+			fail("CSV can't be read");
+
+		write_header(f, 0);
+
+		std::vector<T> labels_;
+		std::size_t count = 0;
+		std::string line;
+		while (std::getline(in, line)) {
+			if (line.empty())
+				continue;
+
+			T values[IN + LABELS];
+			const char* p = line.c_str();
+			for (auto& v : values) {
+				char* end;
+				v = static_cast<T>(std::strtod(p, &end));
+				if (end == p)
+					fail("CSV has wrong line");
+				p = end;
+				while (*p == ',' || *p == ' ' || *p == '\t' || *p == '\r')
+					++p;
+			}
+
+			f.write(reinterpret_cast<const char*>(values), IN * sizeof(T));
+			labels_.insert(labels_.end(), values + IN, values + IN + LABELS);
+			++count;
+		}
+
+		pad(f);
+		f.write(reinterpret_cast<const char*>(labels_.data()),
+				labels_.size() * sizeof(T));
+		f.seekp(0);
+		write_header(f, count);
+		if (not f)
+			fail("can't be written");
 	}
 
    private:
-	// neurons data
-	store_type* data;
-	// ptr to first layer
-	layer_type* layer;
+	// alignment of sections (in bytes)
+	constexpr static std::size_t page = 4096;
+	constexpr static std::uint32_t version = 1;
+	constexpr static std::uint32_t endian = 0x01020304;
+	constexpr static char magic[8] = "net-set";
 
-	// operator for restoring SimpleNet from stream
-	template <typename Tchar>
-	friend std::basic_istream<Tchar>& operator>>(std::basic_istream<Tchar>& s,
-												 SimpleNet<Ss...>& n) {
-		return s.read(reinterpret_cast<Tchar*>(n.data),
-					  net::SimpleNet<Ss...>::data_size * sizeof(store_type));
+	// header of file
+	struct header_type {
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t endian;
+		std::uint32_t store_size;
+		std::uint32_t in_size;
+		std::uint64_t labels_size;
+		std::uint64_t samples;
+		std::uint64_t inputs_offset;
+		std::uint64_t labels_offset;
+	};
+
+	[[noreturn]] static void fail(const char* what) {
+		throw std::runtime_error{std::string{"net::Dataset file "} + what};
 	}
 
-	// operator for saving SimpleNet to stream
-	template <typename Tchar>
-	friend std::basic_ostream<Tchar>& operator<<(std::basic_ostream<Tchar>& s,
-												 const SimpleNet<Ss...>& n) {
-		return s.write(reinterpret_cast<const Tchar*>(n.data),
-					   net::SimpleNet<Ss...>::data_size * sizeof(store_type));
+	// round up @n@ to page
+	constexpr static std::size_t to_page(std::size_t n) {
+		return (n + page - 1) / page * page;
+	}
+
+	// write header of file of @count@ samples and pad it to page
+	static void write_header(std::ofstream& f, std::size_t count) {
+		header_type header{};
+		std::memcpy(header.magic, magic, sizeof(header.magic));
+		header.version = version;
+		header.endian = endian;
+		header.store_size = sizeof(T);
+		header.in_size = IN;
+		header.labels_size = LABELS;
+		header.samples = count;
+		header.inputs_offset = page;
+		header.labels_offset = page + to_page(count * sizeof(feed_type));
+		f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		pad(f);
+	}
+
+	// pad file by zeros to page
+	static void pad(std::ofstream& f) {
+		auto pos = static_cast<std::size_t>(f.tellp());
+		std::vector<char> zeros(to_page(pos) - pos);
+		f.write(zeros.data(), zeros.size());
+	}
+
+	// samples [first, first + count) clamped to dataset
+	view_type view(std::size_t first, std::size_t count) const {
+		first = std::min(first, samples);
+		count = std::min(count, samples - first);
+		return {{inputs + first, count}, labels + first * LABELS, first};
+	}
+
+	// ask system to read block @i@ in background
+	void prefetch(std::size_t i) const {
+#if NET_HAS_MMAP
+		if (i >= blocks() || not mapped)
+			return;
+		auto first = i * block_size;
+		auto count = std::min(block_size, samples - first);
+		advise(inputs + first, count * sizeof(feed_type));
+		advise(labels + first * LABELS, count * LABELS * sizeof(T));
+#else
+		(void)i;
+#endif
+	}
+
+#if NET_HAS_MMAP
+	// madvise(MADV_WILLNEED) range rounded to pages
+	void advise(const void* p, std::size_t n) const {
+		if (n == 0)
+			return;
+		auto begin = reinterpret_cast<std::uintptr_t>(p) / page * page;
+		auto end = reinterpret_cast<std::uintptr_t>(p) + n;
+		::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+	}
+#endif
+
+	// map (or read if mmap isn't available) whole file
+	void map(const std::filesystem::path& path) {
+#if NET_HAS_MMAP
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			fail("can't be read");
+		struct stat st;
+		if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+			::close(fd);
+			fail("can't be read");
+		}
+		file_size = static_cast<std::size_t>(st.st_size);
+		base = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (base == MAP_FAILED) {
+			base = nullptr;
+			fail("can't be mapped");
+		}
+		mapped = true;
+#else
+		std::ifstream f(path, std::ios::binary);
+		file_size = std::filesystem::file_size(path);
+		base = operator new(file_size, std::align_val_t{page});
+		if (not f.read(static_cast<char*>(base), file_size)) {
+			unmap();
+			fail("can't be read");
+		}
+#endif
 	}
+
+	void unmap() {
+		if (base == nullptr)
+			return;
+#if NET_HAS_MMAP
+		if (mapped) {
+			::munmap(base, file_size);
+			base = nullptr;
+			return;
+		}
+#endif
+		operator delete(base, std::align_val_t{page});
+		base = nullptr;
+	}
+
+	// start and size of file in memory
+	void* base = nullptr;
+	std::size_t file_size = 0;
+	bool mapped = false;
+
+	const std::size_t block_size;
+	std::size_t samples = 0;
+	const feed_type* inputs = nullptr;
+	const T* labels = nullptr;
+	// order of blocks for minibatch()
+	std::vector<std::size_t> order;
 };
 
 // class Net store SimpleNets his score and result
-template <typename net_type>
+// random_type is generator used for randomizing and generating new generations
+template <typename net_type, typename random_type = random_engine>
 class Net {
    public:
+	// type of data of networks
+	using storage_type = typename net_type::storage_type;
+	// type of computed values
+	using value_type = typename net_type::value_type;
 	// type used for score of networks
-	using score_type = store_type;
+	using score_type = value_type;
 	// type of output data
 	using result_type = typename net_type::result_type;
 	// type of input data
 	using feed_type = typename net_type::feed_type;
+	// type of networks
+	using network_type = net_type;
 
 	// class for default comparing results and score
 	// return true if first param closest to 0 then second
@@ -477,107 +3567,839 @@ class Net {
 
 	// struct stored network, his score and result
 	struct tuple_type : std::tuple<score_type, net_type, result_type> {
+		using std::tuple<score_type, net_type, result_type>::tuple;
+
 		friend constexpr auto operator<=>(const tuple_type& a,
 										  const tuple_type& b) {
 			return std::get<score_type>(a) <=> std::get<score_type>(b);
 		}
 	};
 
-	template <>
-	struct compare_default<tuple_type> {
-		constexpr bool operator()(const tuple_type& a,
-								  const tuple_type& b) const {
-			return compare_default<score_type>()(std::get<score_type>(a),
-												 std::get<score_type>(b));
-		}
-	};
-
 	// size of input data
 	constexpr static auto in_size = net_type::in_size;
 	// size of output data
 	constexpr static auto out_size = net_type::out_size;
 
+	// alignment of arena and of each network in arena (in bytes)
+	constexpr static std::size_t arena_align = 64;
+	// number of storage_type reserved for each network in arena
+	constexpr static std::size_t net_stride = [] {
+		constexpr auto line = arena_align / sizeof(storage_type);
+		return (net_type::data_size + line - 1) / line * line;
+	}();
+
+	// levels of quantiles of scores reported to observer
+	constexpr static std::array<double, 5> quantile_levels{0.1, 0.25, 0.5,
+														   0.75, 0.9};
+	// number of bins of histogram of scores reported to observer
+	constexpr static std::size_t histogram_size = 16;
+
+	// statistics of generation reported to observer by next()
+	struct stats_type {
+		// number of generation (it's counted by next())
+		std::uint64_t generation = 0;
+		// number of networks
+		std::uint64_t nets = 0;
+		// nanoseconds spent since previous generation by feed(),
+		// count_score() and evaluate(), and by selection and breeding of
+		// this generation
+		std::uint64_t feed_ns = 0;
+		std::uint64_t score_ns = 0;
+		std::uint64_t evaluate_ns = 0;
+		std::uint64_t select_ns = 0;
+		std::uint64_t breed_ns = 0;
+		// scores of networks before selection
+		score_type min{};
+		score_type max{};
+		score_type mean{};
+		// best score selected by Compare class of next()
+		score_type best{};
+		// scores at quantile_levels
+		std::array<score_type, quantile_levels.size()> quantiles{};
+		// number of scores in each of equal bins over [min, max]
+		std::array<std::uint64_t, histogram_size> histogram{};
+		// number of children and number of mutations applied to them
+		std::uint64_t children = 0;
+		std::uint64_t mutations = 0;
+		// number of networks with cached score since previous generation
+		std::uint64_t cached = 0;
+	};
+
+	// function receiving statistics of each generation
+	using observer_type = std::function<void(const stats_type&)>;
+
 	// compute required size and allocate nets
 	// to_use_ is number of nets used for generating new generation
 	// immutable_ is number of nets NOT used for generating new generation
 	//                  but not overrided at generating new generation
 	constexpr Net(std::size_t to_use_, std::size_t immutable_ = 0)
-		: to_use(to_use_),
-		  immutable(immutable_),
-		  nets_size(to_use_ + immutable_ + (to_use * (to_use >> 1))) {
-		if (to_use < 2) {
-			throw std::invalid_argument{"net::Net to_use should be >=2"};
+		: Net(to_use_, immutable_, arena_type{}) {}
+
+	// copy networks with their scores and results
+	Net(const Net& other)
+		: to_use(other.to_use),
+		  immutable(other.immutable),
+		  nets_size(other.nets_size),
+		  pool(other.pool),
+		  rng(other.rng),
+		  crossover_mode(other.crossover_mode),
+		  crossover_points(other.crossover_points),
+		  observer(other.observer),
+		  stats(other.stats),
+		  cache(other.cache) {
+		allocate();
+		std::memcpy(arena.get(), other.arena.get(),
+					weights().size() * sizeof(storage_type));
+		for (std::size_t i = 0; i < nets_size; ++i) {
+			std::get<score_type>(nets[i]) = std::get<score_type>(other.nets[i]);
+			std::get<result_type>(nets[i]) =
+				std::get<result_type>(other.nets[i]);
 		}
-		nets.resize(nets_size);
 	}
 
+	Net(Net&&) = default;
+
 	// check Nets is equal
-	constexpr bool operator==(const Net& other) {
-		for (std::size_t i = 0; i < nets_size; ++i) {
-			auto n1 = std::get<net_type>(nets[i]);
-			auto n2 = std::get<net_type>(other.nets[i]);
-			if (n1 != n2) {
-				return false;
+	constexpr bool operator==(const Net& other) const {
+		return nets_size == other.nets_size &&
+			   0 == std::memcmp(arena.get(), other.arena.get(),
+								weights().size() * sizeof(storage_type));
+	}
+
+	// data of all networks stored back to back, each network takes
+	// net_stride values (the rest of them is zero padding)
+	std::span<const storage_type> weights() const {
+		return {arena.get(), nets_size * net_stride};
+	}
+
+	// save networks, scores, settings and generator state to checkpoint file
+	// file is written next to path and renamed, so checkpoint mapped by load()
+	// can be overwritten
+	void save(const std::filesystem::path& path) const {
+		static_assert(std::is_trivially_copyable_v<random_type>,
+					  "generator state is saved as bytes");
+
+		const auto meta_size = checkpoint_meta_size(nets_size);
+		const auto offset = (meta_size + checkpoint_align - 1) /
+							checkpoint_align * checkpoint_align;
+		const auto weights_bytes = weights().size() * sizeof(storage_type);
+
+		checkpoint_header header{};
+		std::memcpy(header.magic, checkpoint_magic, sizeof(header.magic));
+		header.version = checkpoint_version;
+		header.endian = checkpoint_endian;
+		header.store_size = sizeof(storage_type);
+		header.store_kind = store_kind;
+		header.layers = net_type::layer_sizes.size();
+		header.layout = net_type::layout;
+		header.random_size = sizeof(random_type);
+		header.nets_size = nets_size;
+		header.to_use = to_use;
+		header.immutable = immutable;
+		header.net_stride = net_stride;
+		header.crossover_points = crossover_points;
+		header.crossover_mode = static_cast<std::uint64_t>(crossover_mode);
+		header.weights_offset = offset;
+		header.weights_checksum = checksum(arena.get(), weights_bytes);
+
+		std::vector<char> meta(offset);
+		auto* p = meta.data() + sizeof(header);
+		for (std::uint64_t size : net_type::layer_sizes) {
+			std::memcpy(p, &size, sizeof(size));
+			p += sizeof(size);
+		}
+		std::memcpy(p, &rng, sizeof(rng));
+		p += sizeof(rng);
+		for (const auto& n : nets) {
+			std::memcpy(p, &std::get<score_type>(n), sizeof(score_type));
+			p += sizeof(score_type);
+		}
+
+		std::memcpy(meta.data(), &header, sizeof(header));
+		header.checksum = checksum(meta.data(), meta.size());
+		std::memcpy(meta.data(), &header, sizeof(header));
+
+		auto tmp = path;
+		tmp += ".tmp";
+		{
+			std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+			f.write(meta.data(), meta.size());
+			f.write(reinterpret_cast<const char*>(arena.get()), weights_bytes);
+			if (not f) {
+				throw std::runtime_error{"net::Net can't write checkpoint"};
 			}
 		}
-		return true;
+		std::filesystem::rename(tmp, path);
+	}
+
+	// load Net from checkpoint file created by save()
+	// file is mapped (copy-on-write) and data of networks is used in place,
+	// nothing is parsed or copied except header and scores
+	// data of networks is checked by checksum only if @verify@
+	static Net load(const std::filesystem::path& path, bool verify = false) {
+		auto file = map_checkpoint(path);
+		const auto* bytes = reinterpret_cast<const char*>(file.get());
+		const auto size = file.get_deleter().mapped
+							  ? file.get_deleter().mapped
+							  : std::filesystem::file_size(path);
+
+		auto fail = [](const char* what) {
+			throw std::runtime_error{std::string{"net::Net checkpoint "} +
+									 what};
+		};
+
+		checkpoint_header header;
+		if (size < sizeof(header))
+			fail("is too small");
+		std::memcpy(&header, bytes, sizeof(header));
+
+		if (std::memcmp(header.magic, checkpoint_magic, sizeof(header.magic)))
+			fail("has wrong magic");
+		if (header.version != checkpoint_version)
+			fail("has unsupported version");
+		if (header.endian != checkpoint_endian)
+			fail("has other byte order");
+		if (header.store_size != sizeof(storage_type) ||
+			header.store_kind != store_kind ||
+			header.random_size != sizeof(random_type) ||
+			header.net_stride != net_stride)
+			fail("has other types");
+		if (header.layers != net_type::layer_sizes.size() ||
+			header.layout != net_type::layout)
+			fail("has other topology");
+
+		// counts are bounded by size of file before they are multiplied, so
+		// crafted values can't overflow
+		if (!fits_in(size, header.weights_offset, header.nets_size,
+					 net_stride * sizeof(storage_type)))
+			fail("is truncated");
+		if (header.to_use < 2 || header.to_use > header.nets_size ||
+			header.immutable > header.nets_size ||
+			(header.to_use >> 1) > header.nets_size / header.to_use ||
+			nets_count(header.to_use, header.immutable) != header.nets_size)
+			fail("has wrong number of networks");
+		if (header.weights_offset < checkpoint_meta_size(header.nets_size) ||
+			header.weights_offset % checkpoint_align != 0)
+			fail("has wrong data offset");
+
+		const auto weights_bytes =
+			header.nets_size * net_stride * sizeof(storage_type);
+
+		auto expected = header.checksum;
+		header.checksum = 0;
+		auto sum = checksum(&header, sizeof(header));
+		sum = checksum(bytes + sizeof(header),
+					   header.weights_offset - sizeof(header), sum);
+		if (sum != expected)
+			fail("has wrong checksum");
+
+		const auto* p = bytes + sizeof(header);
+		for (std::uint64_t layer : net_type::layer_sizes) {
+			std::uint64_t size;
+			std::memcpy(&size, p, sizeof(size));
+			p += sizeof(size);
+			if (size != layer)
+				fail("has other topology");
+		}
+
+		auto* data = reinterpret_cast<storage_type*>(
+			file.get() + header.weights_offset / sizeof(storage_type));
+		if (verify && checksum(data, weights_bytes) != header.weights_checksum)
+			fail("has wrong checksum of networks");
+
+		// networks are constructed over mapped data
+		auto deleter = file.get_deleter();
+		file.release();
+		Net o(header.to_use, header.immutable, arena_type{data, deleter});
+
+		std::memcpy(&o.rng, p, sizeof(o.rng));
+		p += sizeof(o.rng);
+		for (auto& n : o.nets) {
+			std::memcpy(&std::get<score_type>(n), p, sizeof(score_type));
+			p += sizeof(score_type);
+		}
+		o.crossover_points = header.crossover_points;
+		o.crossover_mode = static_cast<crossover_type>(header.crossover_mode);
+
+		return o;
+	}
+
+	// combine parents by @type@ crossover in next()
+	// multi_point crossover uses @points@ random points
+	Net& use_crossover(crossover_type type, std::size_t points = 4) {
+		crossover_mode = type;
+		crossover_points = points;
+		return *this;
+	}
+
+	// seed generator, so rand() and next() become reproducible
+	Net& seed(std::uint64_t value) {
+		rng.seed(value);
+		return *this;
+	}
+
+	// randomize all nets
+	constexpr Net& rand() {
+		for (auto& n : nets) {
+			auto& nn = std::get<net_type>(n);
+			nn.rand(rng);
+		}
+		if (not cache.empty())
+			cache.assign(nets_size, cache_entry{});
+		return *this;
+	}
+
+	// cache scores counted by evaluate() and race() for networks which
+	// aren't changed by next() (parents and immutable networks) and for
+	// children same as another network
+	// cached score is added instead of computing network again, so it can
+	// be used only if evaluate() is called with same samples and
+	// deterministic fn for each generation (call use_cache(true) again
+	// if they are changed); scores are exact if they are reset before
+	// feed() and count_score() aren't cached
+	Net& use_cache(bool enable = true) {
+		cache.clear();
+		if (enable)
+			cache.resize(nets_size);
+		return *this;
 	}
 
-	// randomize all nets
-	constexpr Net& rand() {
-		for (auto& n : nets) {
-			auto& nn = std::get<net_type>(n);
-			nn.rand();
-		}
+	// compute feed() and count_score() by threads of pool
+	// pool can be shared by several Nets used from one thread
+	// nullptr for computing in current thread
+	Net& use_pool(std::shared_ptr<ThreadPool> pool_) {
+		pool = std::move(pool_);
+		return *this;
+	}
+
+	// compute feed() and count_score() by own pool of @threads@ threads
+	Net& use_threads(std::size_t threads) {
+		return use_pool(threads > 1 ? std::make_shared<ThreadPool>(threads)
+									: nullptr);
+	}
+
+	// report statistics of each generation to @observer_@ by next()
+	// time and statistics are counted only while observer is used
+	// observer doesn't change results, so generations are same without it
+	Net& use_observer(observer_type observer_) {
+		observer = std::move(observer_);
+		stats = stats_type{stats.generation};
 		return *this;
 	}
 
+	// return observer writing statistics to @s@ as JSON, one line for each
+	// generation
+	static observer_type json_lines(std::ostream& s) {
+		return [&s](const stats_type& st) {
+			// JSON has no NaN or infinity, they are written as null
+			auto score = [&s](score_type v) -> std::ostream& {
+				if (std::isfinite(v))
+					return s << v;
+				return s << "null";
+			};
+			auto list = [&s](const auto& values, auto write) {
+				const char* separator = "[";
+				for (const auto& v : values) {
+					s << separator;
+					write(v);
+					separator = ",";
+				}
+				s << "]";
+			};
+			s << "{\"generation\":" << st.generation
+			  << ",\"nets\":" << st.nets << ",\"feed_ns\":" << st.feed_ns
+			  << ",\"score_ns\":" << st.score_ns
+			  << ",\"evaluate_ns\":" << st.evaluate_ns
+			  << ",\"select_ns\":" << st.select_ns
+			  << ",\"breed_ns\":" << st.breed_ns << ",\"min\":";
+			score(st.min) << ",\"max\":";
+			score(st.max) << ",\"mean\":";
+			score(st.mean) << ",\"best\":";
+			score(st.best) << ",\"quantiles\":";
+			list(st.quantiles, score);
+			s << ",\"histogram\":";
+			list(st.histogram, [&s](std::uint64_t v) { s << v; });
+			s << ",\"children\":" << st.children
+			  << ",\"mutations\":" << st.mutations
+			  << ",\"cached\":" << st.cached << "}\n";
+		};
+	}
+
 	// compute result
+	// networks are stored back to back in arena, so population is computed
+	// by one linear pass over its data
 	constexpr Net& feed(const feed_type& data) {
-		/* TODO: add multithreading */
-		for (auto& n : nets) {
-			auto& nn = std::get<net_type>(n);
-			auto& res = std::get<result_type>(n);
+		timed(stats.feed_ns, [&] {
+			for_each_net([&data](tuple_type& n, std::size_t) {
+				auto& nn = std::get<net_type>(n);
+				auto& res = std::get<result_type>(n);
 
-			res = nn(data);
-		}
+				nn.proccess(data.data(), res.data());
+			});
+		});
 		return *this;
 	}
 
 	// count score for each network
+	// with pool fn is called concurrently; fn(result, thread) is called if
+	// it's possible, thread is in [0, pool size) and can be used for
+	// keeping per-thread state
 	template <typename Fn>
 	constexpr Net& count_score(Fn fn) {
-		/* TODO: add multithreading */
-		for (auto& n : nets) {
-			auto& score = std::get<score_type>(n);
-			const auto& res = std::get<result_type>(n);
+		timed(stats.score_ns, [&] {
+			for_each_net([&fn](tuple_type& n, std::size_t thread) {
+				auto& score = std::get<score_type>(n);
+				const auto& res = std::get<result_type>(n);
 
-			score += fn(res);
-		}
+				if constexpr (std::is_invocable_v<Fn&, const result_type&,
+												  std::size_t>) {
+					score += fn(res, thread);
+				} else {
+					score += fn(res);
+				}
+			});
+		});
+		return *this;
+	}
+
+#if NET_HAS_PROCESS
+	// count score for each network by worker processes of @workers@
+	Net& count_score(ProcessPool<net_type, score_type>& workers) {
+		timed(stats.score_ns, [&] {
+			std::vector<const net_type*> todo(nets_size);
+			std::vector<score_type> scores(nets_size);
+			for (std::size_t i = 0; i < nets_size; ++i) {
+				todo[i] = &std::get<net_type>(nets[i]);
+			}
+			workers.score(todo, scores);
+			for (std::size_t i = 0; i < nets_size; ++i) {
+				std::get<score_type>(nets[i]) += scores[i];
+			}
+		});
 		return *this;
 	}
+#endif
 
 	// generate new generation using mutations and select best score by Compare
 	// class
 	template <template <typename> typename Compare = compare_default>
 	constexpr Net& next(int mutation = 2,
-						Compare<tuple_type> comp = Compare<tuple_type>()) {
-		std::sort(std::begin(nets), std::end(nets), comp);
+						Compare<score_type> comp = Compare<score_type>()) {
+		const auto select_begin = observer ? clock::now() : clock::time_point{};
 
+		// networks aren't moved: only (score, index) pairs are selected
+		// ranks[0, to_use) are parents, ranks[to_use, to_use + immutable)
+		// are kept, networks of the rest ranks are replaced by children
+		// range and sum of scores are counted in same pass for observer
+		score_type lo = std::get<score_type>(nets[0]), hi = lo, sum{};
+		for (std::size_t i = 0; i < nets_size; ++i) {
+			const auto score = std::get<score_type>(nets[i]);
+			ranks[i] = {score, i};
+			if (observer) {
+				lo = std::min(lo, score);
+				hi = std::max(hi, score);
+				sum += score;
+			}
+		}
+
+		auto by_score = [&comp](const rank_type& a, const rank_type& b) {
+			return comp(a.first, b.first);
+		};
+		auto kept = std::begin(ranks) + to_use + immutable;
+		auto parents = std::begin(ranks) + to_use;
+		std::nth_element(std::begin(ranks), kept, std::end(ranks), by_score);
+		std::nth_element(std::begin(ranks), parents, kept, by_score);
+
+		const auto breed_begin = observer ? clock::now() : clock::time_point{};
 		std::size_t child_id = to_use + immutable;
 
 		for (std::size_t i = 0; i < to_use; ++i) {
 			for (std::size_t j = i + 1; j < to_use; ++j) {
-				auto& child = std::get<net_type>(nets[child_id]);
-				auto& parent1 = std::get<net_type>(nets[i]);
-				auto& parent2 = std::get<net_type>(nets[j]);
+				auto& child = std::get<net_type>(nets[ranks[child_id].second]);
+				auto& parent1 = std::get<net_type>(nets[ranks[i].second]);
+				auto& parent2 = std::get<net_type>(nets[ranks[j].second]);
 
-				child = parent1 + parent2 + mutation;
+				child.crossover(parent1, parent2, rng, crossover_mode,
+								crossover_points)
+					.mutation(mutation, rng);
 
 				++child_id;
 			}
 		}
 
+		if (not cache.empty())
+			update_cache();
+
+		++stats.generation;
+		if (observer) {
+			const auto breed_end = clock::now();
+			stats.select_ns += elapsed(select_begin, breed_begin);
+			stats.breed_ns += elapsed(breed_begin, breed_end);
+			stats.children = child_id - to_use - immutable;
+			stats.mutations = stats.children * std::max(mutation, 0);
+			stats.min = lo;
+			stats.max = hi;
+			stats.mean = sum / nets_size;
+			stats.best = std::min_element(std::begin(ranks), parents,
+										  by_score)->first;
+			report();
+		}
+
+		return *this;
+	}
+
+	// compute every network over all samples and count score right after
+	// computing each block of samples, results aren't stored
+	// each network is computed over the whole dataset at once, so its data is
+	// loaded from memory once instead of once per sample
+	// fn(result, sample) is called for each sample (sample is its index)
+	// with pool fn is called concurrently; fn(result, sample, thread) is
+	// called if it's possible for keeping per-thread state
+	template <typename Fn>
+	Net& evaluate(std::span<const feed_type> samples, Fn fn) {
+		constexpr auto block = net_type::batch_size;
+		const auto threads = pool ? pool->size() : 1;
+
+		const auto begin = observer ? clock::now() : clock::time_point{};
+
+		// workspace and results of block for each thread
+		std::vector<value_type> workspace(net_type::workspace_size * threads);
+		std::vector<result_type> results(block * threads);
+
+		if (cache.empty()) {
+			for_each_net([&](tuple_type& n, std::size_t thread) {
+				score_samples(
+					n, samples, 0, fn,
+					workspace.data() + net_type::workspace_size * thread,
+					results.data() + block * thread, thread);
+			});
+		} else {
+			std::vector<score_type> base;
+			auto todo = use_cached(base, false);
+			for_each_index(todo.size(), [&](std::size_t i,
+											std::size_t thread) {
+				score_samples(
+					nets[todo[i]], samples, 0, fn,
+					workspace.data() + net_type::workspace_size * thread,
+					results.data() + block * thread, thread);
+			});
+			store_cached(todo, base);
+
+			// children same as computed network
+			for (std::size_t i = 0; i < nets_size; ++i) {
+				auto& entry = cache[i];
+				if (entry.same_as == cache_entry::none)
+					continue;
+				entry = cache[entry.same_as];
+				std::get<score_type>(nets[i]) += entry.score;
+				++stats.cached;
+			}
+		}
+		if (observer)
+			stats.evaluate_ns += elapsed(begin, clock::now());
+		return *this;
+	}
+
+	// same as evaluate() but networks which can't be selected by next() are
+	// dropped early (racing by successive halving)
+	// networks are computed over slices of samples, first slice has
+	// @first_slice@ samples and every next slice is twice bigger
+	// after each slice half of remaining networks with worst estimated
+	// score (by Compare class) is dropped, but networks number never falls
+	// below @margin@ times number of networks kept by next()
+	// survivors are computed over all samples and get same score as by
+	// evaluate(), score of dropped network is its partial score scaled to
+	// all samples but not better than score of any survivor, so dropped
+	// networks aren't selected by next() before survivors
+	template <template <typename> typename Compare = compare_default,
+			  typename Fn>
+	Net& race(std::span<const feed_type> samples, Fn fn,
+			  std::size_t first_slice = 64, double margin = 2.,
+			  Compare<score_type> comp = Compare<score_type>()) {
+		constexpr auto block = net_type::batch_size;
+		const auto threads = pool ? pool->size() : 1;
+		const auto total = samples.size();
+		const auto needed = std::max(
+			to_use + immutable,
+			static_cast<std::size_t>(std::ceil(margin * (to_use + immutable))));
+
+		const auto begin = observer ? clock::now() : clock::time_point{};
+
+		std::vector<value_type> workspace(net_type::workspace_size * threads);
+		std::vector<result_type> results(block * threads);
+
+		// scores before racing, remaining and dropped networks
+		// networks with cached score aren't raced
+		std::vector<score_type> base;
+		auto alive = use_cached(base, true);
+		std::vector<std::size_t> dropped;
+		if (alive.empty()) {
+			if (observer)
+				stats.evaluate_ns += elapsed(begin, clock::now());
+			return *this;
+		}
+
+		std::size_t done = 0;
+		std::size_t slice = std::max<std::size_t>(first_slice, 1);
+		while (done < total) {
+			const auto end = std::min(total, done + slice);
+			for_each_index(alive.size(), [&](std::size_t i,
+											 std::size_t thread) {
+				score_samples(
+					nets[alive[i]], samples.subspan(done, end - done), done,
+					fn, workspace.data() + net_type::workspace_size * thread,
+					results.data() + block * thread, thread);
+			});
+			done = end;
+			slice *= 2;
+
+			if (done == total || alive.size() <= needed)
+				continue;
+
+			// partial scores scaled to all samples
+			const auto scale = static_cast<score_type>(total) / done;
+			auto estimate = [&](std::size_t i) {
+				return base[i] +
+					   (std::get<score_type>(nets[i]) - base[i]) * scale;
+			};
+			auto keep = std::max(needed, alive.size() / 2);
+			std::nth_element(std::begin(alive), std::begin(alive) + keep,
+							 std::end(alive),
+							 [&](std::size_t a, std::size_t b) {
+								 return comp(estimate(a), estimate(b));
+							 });
+			for (auto i = keep; i < alive.size(); ++i) {
+				std::get<score_type>(nets[alive[i]]) = estimate(alive[i]);
+				dropped.push_back(alive[i]);
+			}
+			alive.resize(keep);
+		}
+
+		// survivors (and networks with cached score) have exact score
+		store_cached(alive, base);
+		auto worst = std::get<score_type>(nets[alive[0]]);
+		auto update_worst = [&](std::size_t i) {
+			const auto score = std::get<score_type>(nets[i]);
+			if (comp(worst, score))
+				worst = score;
+		};
+		for (auto i : alive) {
+			update_worst(i);
+		}
+		for (std::size_t i = 0; i < cache.size(); ++i) {
+			if (cache[i].valid)
+				update_worst(i);
+		}
+		for (auto i : dropped) {
+			auto& score = std::get<score_type>(nets[i]);
+			if (comp(score, worst))
+				score = worst;
+		}
+
+		if (observer)
+			stats.evaluate_ns += elapsed(begin, clock::now());
+		return *this;
+	}
+
+	// steady-state evolution without generations: each thread of pool
+	// repeatedly breeds child of two parents selected by tournaments of
+	// @tournament@ random networks, counts its score by fn(child) and
+	// replaces worst network of another tournament if child is better by
+	// Compare class, until @evaluations@ children are scored
+	// threads don't wait for each other, so uneven cost of fn doesn't leave
+	// them idle; fn(child, thread) is called if it's possible
+	// scores of networks should be counted before by same measure as fn,
+	// every network is a parent and a network is replaced only by better
+	// child (to_use and immutable aren't used), so best score never gets
+	// worse
+	// scores are read without locks and each network is locked only while
+	// it's bred from or replaced; with pool order of replacements depends
+	// on timing, so results are reproducible only without pool
+	template <template <typename> typename Compare = compare_default,
+			  typename Fn>
+	Net& steady_state(std::size_t evaluations, Fn fn, int mutation = 2,
+					  std::size_t tournament = 2,
+					  Compare<score_type> comp = Compare<score_type>()) {
+		if (tournament == 0) {
+			throw std::invalid_argument{
+				"net::Net::steady_state tournament should not be empty"};
+		}
+
+		std::vector<std::atomic<score_type>> scores(nets_size);
+		for (std::size_t i = 0; i < nets_size; ++i) {
+			scores[i].store(std::get<score_type>(nets[i]),
+							std::memory_order_relaxed);
+		}
+		std::vector<std::atomic_flag> locks(nets_size);
+		auto lock = [&locks](std::size_t i) {
+			while (locks[i].test_and_set(std::memory_order_acquire)) {
+				locks[i].wait(true, std::memory_order_relaxed);
+			}
+		};
+		auto unlock = [&locks](std::size_t i) {
+			locks[i].clear(std::memory_order_release);
+			locks[i].notify_one();
+		};
+
+		auto select = [&](random_type& gen, bool best) {
+			return tournament_select(
+				gen, tournament, best, comp, [&scores](std::size_t i) {
+					return scores[i].load(std::memory_order_relaxed);
+				});
+		};
+
+		std::atomic<std::size_t> started{0};
+		auto work = [&](random_type& gen, net_type& child,
+						std::size_t thread) {
+			while (started.fetch_add(1, std::memory_order_relaxed) <
+				   evaluations) {
+				// parents are locked in order of indexes, so two threads
+				// never wait for each other
+				auto a = select(gen, true), b = select(gen, true);
+				lock(std::min(a, b));
+				if (a != b)
+					lock(std::max(a, b));
+				child.crossover(std::get<net_type>(nets[a]),
+								std::get<net_type>(nets[b]), gen,
+								crossover_mode, crossover_points);
+				if (a != b)
+					unlock(std::max(a, b));
+				unlock(std::min(a, b));
+				child.mutation(mutation, gen);
+
+				const auto& scored = child;
+				score_type score;
+				if constexpr (std::is_invocable_v<Fn&, const net_type&,
+												  std::size_t>) {
+					score = fn(scored, thread);
+				} else {
+					score = fn(scored);
+				}
+
+				// worst network is checked again under lock, it could be
+				// replaced by another thread
+				auto w = select(gen, false);
+				lock(w);
+				if (comp(score, scores[w].load(std::memory_order_relaxed))) {
+					std::get<net_type>(nets[w]) = child;
+					scores[w].store(score, std::memory_order_relaxed);
+				}
+				unlock(w);
+			}
+		};
+
+		const auto workers = pool ? pool->size() : 1;
+		std::vector<random_type> gens;
+		std::vector<net_type> children(workers);
+		gens.reserve(workers);
+		for (std::size_t i = 0; i < workers; ++i) {
+			gens.emplace_back(rng());
+		}
+		if (pool) {
+			pool->parallel_for(
+				workers, 1, [&](std::size_t b, std::size_t, std::size_t t) {
+					work(gens[b], children[b], t);
+				});
+		} else {
+			work(gens[0], children[0], 0);
+		}
+
+		for (std::size_t i = 0; i < nets_size; ++i) {
+			std::get<score_type>(nets[i]) =
+				scores[i].load(std::memory_order_relaxed);
+		}
+		if (not cache.empty())
+			cache.assign(nets_size, cache_entry{});
+		return *this;
+	}
+
+	// steady-state evolution scored asynchronously: fn(child) starts scoring
+	// and returns future of score (std::future or any type with wait_for()
+	// and get()), @in_flight@ children are scored at once and new children
+	// are bred while earlier ones are scored, so latency of fn is hidden
+	// child stays valid until its future is ready; finished child replaces
+	// worst network of tournament if it's better by Compare class (same as
+	// steady_state(), but breeding and replacing are done by caller thread)
+	// finished futures are taken in any order, oldest one is waited for if
+	// none is ready, so results are reproducible if futures are deferred
+	template <template <typename> typename Compare = compare_default,
+			  typename Fn>
+	Net& steady_state_async(std::size_t evaluations, Fn fn,
+							std::size_t in_flight, int mutation = 2,
+							std::size_t tournament = 2,
+							Compare<score_type> comp = Compare<score_type>()) {
+		if (tournament == 0 || in_flight == 0) {
+			throw std::invalid_argument{
+				"net::Net::steady_state_async tournament and in_flight "
+				"should not be empty"};
+		}
+
+		using future_type = std::invoke_result_t<Fn&, const net_type&>;
+		auto score_of = [this](std::size_t i) {
+			return std::get<score_type>(nets[i]);
+		};
+
+		// children and their futures, scoring holds indexes of children in
+		// order of start and free holds unused children
+		std::vector<net_type> children(std::min(in_flight, evaluations));
+		std::vector<std::optional<future_type>> futures(children.size());
+		std::deque<std::size_t> scoring;
+		std::vector<std::size_t> free(children.size());
+		for (std::size_t i = 0; i < free.size(); ++i) {
+			free[i] = free.size() - 1 - i;
+		}
+
+		auto finish = [&](std::size_t c) {
+			const score_type score = futures[c]->get();
+			futures[c].reset();
+			auto w = tournament_select(rng, tournament, false, comp, score_of);
+			if (comp(score, std::get<score_type>(nets[w]))) {
+				std::get<net_type>(nets[w]) = children[c];
+				std::get<score_type>(nets[w]) = score;
+			}
+			free.push_back(c);
+		};
+
+		std::size_t started = 0;
+		while (started < evaluations || not scoring.empty()) {
+			while (started < evaluations && not free.empty()) {
+				auto c = free.back();
+				free.pop_back();
+				auto a = tournament_select(rng, tournament, true, comp,
+										   score_of);
+				auto b = tournament_select(rng, tournament, true, comp,
+										   score_of);
+				children[c]
+					.crossover(std::get<net_type>(nets[a]),
+							   std::get<net_type>(nets[b]), rng,
+							   crossover_mode, crossover_points)
+					.mutation(mutation, rng);
+				const auto& child = children[c];
+				futures[c].emplace(fn(child));
+				scoring.push_back(c);
+				++started;
+			}
+
+			// take finished children, or wait for oldest one
+			std::size_t finished = 0;
+			for (auto it = scoring.begin(); it != scoring.end();) {
+				if (futures[*it]->wait_for(std::chrono::seconds{0}) ==
+					std::future_status::ready) {
+					finish(*it);
+					it = scoring.erase(it);
+					++finished;
+				} else {
+					++it;
+				}
+			}
+			if (finished == 0 && not scoring.empty()) {
+				finish(scoring.front());
+				scoring.pop_front();
+			}
+		}
+
+		if (not cache.empty())
+			cache.assign(nets_size, cache_entry{});
 		return *this;
 	}
 
@@ -592,6 +4414,28 @@ class Net {
 		return o / nets_size;
 	}
 
+	// return score of network @i@
+	constexpr score_type score(std::size_t i) const {
+		return std::get<score_type>(nets[i]);
+	}
+
+	// return number of networks
+	constexpr std::size_t size() const noexcept { return nets_size; }
+
+	// return network @i@
+	constexpr const net_type& network(std::size_t i) const {
+		return std::get<net_type>(nets[i]);
+	}
+
+	// replace data of network @i@ by data of @n@ and its score by @score@
+	Net& replace(std::size_t i, const net_type& n, score_type score) {
+		std::get<net_type>(nets[i]) = n;
+		std::get<score_type>(nets[i]) = score;
+		if (not cache.empty())
+			cache[i] = cache_entry{};
+		return *this;
+	}
+
 	// return best score selected by Compare class
 	template <template <typename> typename Compare = compare_default>
 	constexpr score_type best_score(Compare<score_type> comp = {}) const {
@@ -649,12 +4493,608 @@ class Net {
 	}
 
    private:
+	// score of network and its index
+	using rank_type = std::pair<score_type, std::size_t>;
+	// clock measuring time for observer
+	using clock = std::chrono::steady_clock;
+
+	// cached score of network (added to its score by evaluate())
+	struct cache_entry {
+		constexpr static auto none = ~std::size_t{0};
+
+		score_type score{};
+		bool valid = false;
+		// index of network with same data which isn't computed yet
+		std::size_t same_as = none;
+	};
+
+	// save scores to @base@, add cached scores and return networks which
+	// should be computed (duplicates of other networks are computed too if
+	// @duplicates@)
+	// without cache all networks should be computed
+	std::vector<std::size_t> use_cached(std::vector<score_type>& base,
+										bool duplicates) {
+		std::vector<std::size_t> todo;
+		base.resize(nets_size);
+		for (std::size_t i = 0; i < nets_size; ++i) {
+			auto& score = std::get<score_type>(nets[i]);
+			base[i] = score;
+			if (cache.empty()) {
+				todo.push_back(i);
+			} else if (cache[i].valid) {
+				score += cache[i].score;
+				++stats.cached;
+			} else if (duplicates || cache[i].same_as == cache_entry::none) {
+				cache[i].same_as = cache_entry::none;
+				todo.push_back(i);
+			}
+		}
+		return todo;
+	}
+
+	// cache scores added to computed networks
+	void store_cached(const std::vector<std::size_t>& computed,
+					  const std::vector<score_type>& base) {
+		if (cache.empty())
+			return;
+		for (auto i : computed) {
+			cache[i].score = std::get<score_type>(nets[i]) - base[i];
+			cache[i].valid = true;
+		}
+	}
+
+	// keep cache of networks which aren't changed by next() and find
+	// children same as other networks
+	void update_cache() {
+		const auto bytes = net_type::data_size * sizeof(storage_type);
+		auto data = [this](std::size_t i) {
+			return arena.get() + i * net_stride;
+		};
+
+		same_nets.clear();
+		for (std::size_t r = 0; r < nets_size; ++r) {
+			const auto i = ranks[r].second;
+			const auto hash = words_hash(data(i), bytes);
+			auto [it, inserted] = same_nets.try_emplace(hash, i);
+			if (r < to_use + immutable) {
+				// it will be computed if its score isn't cached
+				cache[i].same_as = cache_entry::none;
+				continue;
+			}
+
+			// child
+			cache[i] = cache_entry{};
+			if (inserted || std::memcmp(data(i), data(it->second), bytes))
+				continue;
+			if (cache[it->second].valid) {
+				cache[i] = cache[it->second];
+			} else {
+				cache[i].same_as = it->second;
+			}
+		}
+	}
+
+	// nanoseconds between @begin@ and @end@
+	static std::uint64_t elapsed(clock::time_point begin,
+								 clock::time_point end) {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(end -
+																	begin)
+			.count();
+	}
+
+	// call fn and add its time to @ns@ if observer is used
+	template <typename Fn>
+	void timed(std::uint64_t& ns, Fn&& fn) {
+		if (not observer) {
+			fn();
+			return;
+		}
+		const auto begin = clock::now();
+		fn();
+		ns += elapsed(begin, clock::now());
+	}
+
+	// count quantiles and histogram of scores in ranks (they aren't needed
+	// by next() after breeding) and pass statistics to observer
+	void report() {
+		stats.nets = nets_size;
+
+		auto first = std::begin(ranks);
+		for (std::size_t q = 0; q < quantile_levels.size(); ++q) {
+			auto nth = std::begin(ranks) +
+					   static_cast<std::size_t>(quantile_levels[q] *
+												(nets_size - 1));
+			std::nth_element(first, nth, std::end(ranks));
+			stats.quantiles[q] = nth->first;
+			first = nth;
+		}
+
+		const auto width = stats.max - stats.min;
+		for (const auto& r : ranks) {
+			std::size_t bin = 0;
+			if (width > 0) {
+				bin = static_cast<std::size_t>((r.first - stats.min) / width *
+											   histogram_size);
+			}
+			// NaN scores aren't in range
+			if (r.first >= stats.min && r.first <= stats.max)
+				++stats.histogram[std::min(bin, histogram_size - 1)];
+		}
+
+		observer(stats);
+		stats = stats_type{stats.generation};
+	}
+
+	// deleter for arena allocated with arena_align
+	// base is start of allocation or mapping if arena starts inside it
+	// mapped is size of mapping (0 if arena isn't mapped)
+	struct arena_deleter {
+		void* base = nullptr;
+		std::size_t mapped = 0;
+
+		void operator()(storage_type* p) const {
+#if NET_HAS_MMAP
+			if (mapped != 0) {
+				munmap(base, mapped);
+				return;
+			}
+#endif
+			operator delete[](base ? base : p, std::align_val_t{arena_align});
+		}
+	};
+	using arena_type = std::unique_ptr<storage_type[], arena_deleter>;
+
+	// alignment of data of networks in checkpoint (in bytes)
+	constexpr static std::size_t checkpoint_align = 4096;
+	constexpr static std::uint32_t checkpoint_version = 2;
+	// kind of storage_type: 0 is IEEE 754 (float, double, half), 1 is bfloat16
+	constexpr static std::uint32_t store_kind =
+		std::is_same_v<storage_type, bfloat16> ? 1 : 0;
+	constexpr static std::uint32_t checkpoint_endian = 0x01020304;
+
+	// header of checkpoint file
+	// header is followed by layer sizes (std::uint64_t each), generator
+	// state, scores of networks, zero padding up to weights_offset and
+	// data of networks (same as arena)
+	struct checkpoint_header {
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t endian;
+		std::uint32_t store_size;
+		std::uint32_t store_kind;
+		std::uint32_t layers;
+		std::uint32_t layout;
+		std::uint64_t random_size;
+		std::uint64_t nets_size;
+		std::uint64_t to_use;
+		std::uint64_t immutable;
+		std::uint64_t net_stride;
+		std::uint64_t crossover_points;
+		std::uint64_t crossover_mode;
+		std::uint64_t weights_offset;
+		// checksum of data of networks
+		std::uint64_t weights_checksum;
+		// checksum of everything before weights_offset (with zero checksum)
+		std::uint64_t checksum;
+	};
+
+	// magic of checkpoint files
+	constexpr static char checkpoint_magic[8] = "net-ckp";
+
+	// size of metadata before data of @count@ networks
+	constexpr static std::size_t checkpoint_meta_size(std::size_t count) {
+		return sizeof(checkpoint_header) +
+			   net_type::layer_sizes.size() * sizeof(std::uint64_t) +
+			   sizeof(random_type) + count * sizeof(score_type);
+	}
+
+	// number of networks used for @to_use_@ and @immutable_@
+	constexpr static std::size_t nets_count(std::size_t to_use_,
+											std::size_t immutable_) {
+		return to_use_ + immutable_ + (to_use_ * (to_use_ >> 1));
+	}
+
+	// construct Net over arena (arena is allocated if it's empty)
+	Net(std::size_t to_use_, std::size_t immutable_, arena_type arena_)
+		: to_use(to_use_),
+		  immutable(immutable_),
+		  nets_size(nets_count(to_use_, immutable_)),
+		  arena(std::move(arena_)) {
+		if (to_use < 2) {
+			throw std::invalid_argument{"net::Net to_use should be >=2"};
+		}
+		allocate();
+	}
+
+	// map (or read if mmap isn't available) whole checkpoint file
+	// returned pointer is start of file
+	static arena_type map_checkpoint(const std::filesystem::path& path) {
+		auto fail = [] {
+			throw std::runtime_error{"net::Net can't read checkpoint"};
+		};
+#if NET_HAS_MMAP
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			fail();
+		struct stat st;
+		if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+			::close(fd);
+			fail();
+		}
+		auto size = static_cast<std::size_t>(st.st_size);
+		void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+							MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (base == MAP_FAILED)
+			fail();
+		return arena_type{static_cast<storage_type*>(base),
+						  arena_deleter{base, size}};
+#else
+		std::ifstream f(path, std::ios::binary);
+		auto size = std::filesystem::file_size(path);
+		auto count = (size + sizeof(storage_type) - 1) / sizeof(storage_type);
+		auto* base = new (std::align_val_t{arena_align}) storage_type[count]();
+		arena_type o{base, arena_deleter{base, 0}};
+		if (not f.read(reinterpret_cast<char*>(o.get()), size))
+			fail();
+		return o;
+#endif
+	}
+
+	// random network of tournament of @size@ networks with best (or worst)
+	// score by @comp@, score_of(i) is score of network i
+	template <typename Compare, typename ScoreOf>
+	std::size_t tournament_select(random_type& gen, std::size_t size,
+								  bool best, const Compare& comp,
+								  ScoreOf score_of) const {
+		std::uniform_int_distribution<std::size_t> index(0, nets_size - 1);
+		auto o = index(gen);
+		auto o_score = score_of(o);
+		for (std::size_t k = 1; k < size; ++k) {
+			auto i = index(gen);
+			auto score = score_of(i);
+			if (best ? comp(score, o_score) : comp(o_score, score)) {
+				o = i;
+				o_score = score;
+			}
+		}
+		return o;
+	}
+
+	// call fn(tuple, thread) for each network, by pool if it's used
+	template <typename Fn>
+	void for_each_net(Fn fn) {
+		for_each_index(nets_size, [this, &fn](std::size_t i,
+											  std::size_t thread) {
+			fn(nets[i], thread);
+		});
+	}
+
+	// call fn(i, thread) for each i in [0, count), by pool if it's used
+	template <typename Fn>
+	void for_each_index(std::size_t count, Fn fn) {
+		if (not pool) {
+			for (std::size_t i = 0; i < count; ++i) {
+				fn(i, 0);
+			}
+			return;
+		}
+
+		// few chunks per thread for balancing uneven chunks
+		auto chunk = count / (pool->size() * 4);
+		pool->parallel_for(
+			count, chunk,
+			[&fn](std::size_t b, std::size_t e, std::size_t thread) {
+				for (auto i = b; i < e; ++i) {
+					fn(i, thread);
+				}
+			});
+	}
+
+	// compute network @n@ over samples and add their scores to its score
+	// index of first sample is @first@, ws and out are workspace and
+	// results of block of current thread
+	template <typename Fn>
+	void score_samples(tuple_type& n, std::span<const feed_type> samples,
+					   std::size_t first, Fn& fn, value_type* ws,
+					   result_type* out, std::size_t thread) {
+		constexpr auto block = net_type::batch_size;
+		const auto& nn = std::get<net_type>(n);
+		auto& score = std::get<score_type>(n);
+
+		for (std::size_t b = 0; b < samples.size(); b += block) {
+			auto count = std::min(block, samples.size() - b);
+			nn.proccess_batch(samples[b].data(), count, out->data(), ws);
+
+			for (std::size_t s = 0; s < count; ++s) {
+				const auto& res = out[s];
+				const auto sample = first + b + s;
+				if constexpr (std::is_invocable_v<Fn&, const result_type&,
+												  std::size_t, std::size_t>) {
+					score += fn(res, sample, thread);
+				} else {
+					score += fn(res, sample);
+				}
+			}
+		}
+	}
+
+	// allocate zeroed arena (if it isn't allocated) and construct networks
+	// over it
+	void allocate() {
+		if (not arena) {
+			arena.reset(new (std::align_val_t{arena_align})
+							storage_type[nets_size * net_stride]());
+		}
+		ranks.resize(nets_size);
+		nets.reserve(nets_size);
+		for (std::size_t i = 0; i < nets_size; ++i) {
+			nets.emplace_back(score_type{}, arena.get() + i * net_stride,
+							  result_type{});
+		}
+	}
+
 	const std::size_t to_use;
 	const std::size_t immutable;
 	const std::size_t nets_size;
 
-	// networks
+	// data of all networks
+	arena_type arena;
+	// networks (their data is in arena)
 	std::vector<tuple_type> nets;
+	// networks ordered by next()
+	std::vector<rank_type> ranks;
+	// threads computing networks
+	std::shared_ptr<ThreadPool> pool;
+	// generator for randomizing and generating new generations
+	random_type rng{random_seed()};
+	// crossover used by next()
+	crossover_type crossover_mode = crossover_type::two_point;
+	std::size_t crossover_points = 4;
+	// receiver of statistics and statistics of current generation
+	observer_type observer;
+	stats_type stats;
+	// cached scores (empty if cache isn't used) and networks by hash of
+	// their data
+	std::vector<cache_entry> cache;
+	std::unordered_map<std::uint64_t, std::size_t> same_nets;
+};
+
+// ways of migration between islands
+enum class migration_topology {
+	// island i sends migrants to island (i + 1) % count
+	ring,
+	// every island sends migrants to every other island
+	fully_connected,
+};
+
+namespace {
+// bounded lock-free queue with one producer and one consumer
+template <typename T>
+class SpscQueue {
+   public:
+	explicit SpscQueue(std::size_t capacity) : slots(capacity + 1) {}
+
+	// move @value@ to queue, return false if queue is full
+	bool push(T& value) {
+		const auto t = tail.load(std::memory_order_relaxed);
+		const auto next = (t + 1) % slots.size();
+		if (next == head.load(std::memory_order_acquire))
+			return false;
+		slots[t] = std::move(value);
+		tail.store(next, std::memory_order_release);
+		return true;
+	}
+
+	// move first value of queue to @value@, return false if queue is empty
+	bool pop(T& value) {
+		const auto h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire))
+			return false;
+		value = std::move(slots[h]);
+		head.store((h + 1) % slots.size(), std::memory_order_release);
+		return true;
+	}
+
+   private:
+	std::vector<T> slots;
+	alignas(64) std::atomic<std::size_t> head = 0;
+	alignas(64) std::atomic<std::size_t> tail = 0;
+};
+}  // namespace
+
+// class Islands contain independent populations (Nets) evolved by separate
+// threads, best networks migrate between them every few generations
+// islands aren't synchronized: migrants are passed through lock-free queues
+// and island takes migrants which have already arrived, so results depend
+// on timing of threads unless one thread is used
+template <typename population_type,
+		  template <typename> typename Compare =
+			  population_type::template compare_default>
+class Islands {
+   public:
+	// type of networks
+	using net_type = typename population_type::network_type;
+	// type used for score of networks
+	using score_type = typename population_type::score_type;
+
+	// construct @count@ islands of Net(@to_use@, @immutable@) evolved by
+	// @threads@ threads (by thread for each island if it's 0)
+	Islands(std::size_t count, std::size_t to_use, std::size_t immutable = 0,
+			std::size_t threads = 0)
+		: pool(std::make_shared<ThreadPool>(threads ? threads : count)) {
+		if (count == 0) {
+			throw std::invalid_argument{"net::Islands count should be >=1"};
+		}
+		islands.reserve(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			islands.emplace_back(to_use, immutable);
+		}
+		use_migration(migration_topology::ring);
+	}
+
+	// number of islands
+	std::size_t size() const noexcept { return islands.size(); }
+
+	// island @i@
+	population_type& operator[](std::size_t i) { return islands[i]; }
+	const population_type& operator[](std::size_t i) const {
+		return islands[i];
+	}
+
+	// seed generators of islands, island i is seeded by @value@ + i
+	Islands& seed(std::uint64_t value) {
+		for (std::size_t i = 0; i < islands.size(); ++i) {
+			islands[i].seed(value + i);
+		}
+		return *this;
+	}
+
+	// randomize networks of all islands
+	Islands& rand() {
+		for (auto& island : islands) {
+			island.rand();
+		}
+		return *this;
+	}
+
+	// send @migrants@ best networks of each island by @topology@ every
+	// @interval@ generations, they replace the worst networks of receivers
+	// queues keep migrants of few migrations, if receiver is too slow
+	// newer migrants are dropped
+	Islands& use_migration(migration_topology topology,
+						   std::size_t interval = 10,
+						   std::size_t migrants_ = 1) {
+		migration_interval = std::max<std::size_t>(interval, 1);
+		migrants = migrants_;
+
+		const auto count = islands.size();
+		queues.clear();
+		outgoing.assign(count, {});
+		incoming.assign(count, {});
+		auto connect = [&](std::size_t from, std::size_t to) {
+			outgoing[from].push_back(queues.size());
+			incoming[to].push_back(queues.size());
+			queues.push_back(std::make_unique<queue_type>(migrants * 4));
+		};
+		for (std::size_t i = 0; i < count && count > 1; ++i) {
+			if (topology == migration_topology::ring) {
+				connect(i, (i + 1) % count);
+				continue;
+			}
+			for (std::size_t j = 0; j < count; ++j) {
+				if (j != i)
+					connect(i, j);
+			}
+		}
+		return *this;
+	}
+
+	// evolve every island by its thread for @generations@ generations
+	// each generation fn(island, index) counts score of networks of island
+	// (e.g. by reset_score() and evaluate()), then migrants are exchanged
+	// (every interval generations) and next generation is generated by
+	// next(@mutation@)
+	// islands don't share anything except queues of migrants
+	template <typename Fn>
+	Islands& run(std::size_t generations, Fn fn, int mutation = 2) {
+		pool->parallel_for(
+			islands.size(), 1,
+			[&](std::size_t b, std::size_t e, std::size_t) {
+				for (auto i = b; i < e; ++i) {
+					evolve(i, generations, fn, mutation);
+				}
+			});
+		generation += generations;
+		return *this;
+	}
+
+	// number of generations made by run()
+	std::uint64_t generations() const noexcept { return generation; }
+
+	// index of island with the best score
+	std::size_t best() const {
+		Compare<score_type> comp;
+		std::size_t o = 0;
+		for (std::size_t i = 1; i < islands.size(); ++i) {
+			if (comp(islands[i].template best_score<Compare>(),
+					 islands[o].template best_score<Compare>()))
+				o = i;
+		}
+		return o;
+	}
+
+	// the best score of all islands
+	score_type best_score() const {
+		return islands[best()].template best_score<Compare>();
+	}
+
+   private:
+	// network sent to other island with its score
+	struct migrant {
+		net_type net;
+		score_type score{};
+	};
+	using queue_type = SpscQueue<migrant>;
+
+	// evolve island @i@
+	template <typename Fn>
+	void evolve(std::size_t i, std::size_t generations, Fn& fn, int mutation) {
+		auto& island = islands[i];
+		for (std::size_t g = 0; g < generations; ++g) {
+			fn(island, i);
+			if ((generation + g + 1) % migration_interval == 0)
+				migrate(i);
+			island.template next<Compare>(mutation);
+		}
+	}
+
+	// send best networks of island @i@ and replace its worst networks by
+	// arrived migrants
+	void migrate(std::size_t i) {
+		auto& island = islands[i];
+		Compare<score_type> comp;
+
+		std::vector<std::size_t> order(island.size());
+		for (std::size_t j = 0; j < order.size(); ++j) {
+			order[j] = j;
+		}
+		std::sort(std::begin(order), std::end(order),
+				  [&](std::size_t a, std::size_t b) {
+					  return comp(island.score(a), island.score(b));
+				  });
+
+		const auto count = std::min(migrants, order.size());
+		migrant m;
+		for (auto q : outgoing[i]) {
+			for (std::size_t k = 0; k < count; ++k) {
+				m.net = island.network(order[k]);
+				m.score = island.score(order[k]);
+				if (not queues[q]->push(m))
+					break;
+			}
+		}
+
+		// the best networks aren't replaced
+		auto worst = order.size();
+		for (auto q : incoming[i]) {
+			while (worst > count && queues[q]->pop(m)) {
+				island.replace(order[--worst], m.net, m.score);
+			}
+		}
+	}
+
+	std::vector<population_type> islands;
+	// queues of migrants and their indexes for each island
+	std::vector<std::unique_ptr<queue_type>> queues;
+	std::vector<std::vector<std::size_t>> outgoing;
+	std::vector<std::vector<std::size_t>> incoming;
+	std::size_t migration_interval = 10;
+	std::size_t migrants = 1;
+	// number of generations made by run()
+	std::uint64_t generation = 0;
+	// threads evolving islands
+	std::shared_ptr<ThreadPool> pool;
 };
 
 }  // namespace net
@@ -0,0 +1,16 @@
+#include <Net.hh>
+
+// writes network used by benchmark simple/exported/small
+int main(int argc, char** argv) {
+	if (argc != 2)
+		return 1;
+
+	net::random_engine gen{1};
+	net::SimpleNet<8, 16, 4> n;
+	n.rand(gen);
+	n.save_header(argv[1], "small_net");
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,180 @@
+#include "harness.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <Net.hh>
+
+// number of calls of operator new
+static std::atomic<std::size_t> total_allocations = 0;
+
+void* operator new(std::size_t size) {
+	total_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc{};
+}
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+void* operator new(std::size_t size, std::align_val_t align) {
+	total_allocations.fetch_add(1, std::memory_order_relaxed);
+	auto a = std::max(static_cast<std::size_t>(align), sizeof(void*));
+	if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a))
+		return p;
+	throw std::bad_alloc{};
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+	return operator new(size, align);
+}
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+void operator delete[](void* p) noexcept {
+	std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+	std::free(p);
+}
+void operator delete[](void* p, std::size_t) noexcept {
+	std::free(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept {
+	std::free(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept {
+	std::free(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+	std::free(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+	std::free(p);
+}
+
+namespace bench {
+namespace {
+struct entry {
+	std::string name;
+	body_type body;
+};
+
+std::vector<entry>& registry() {
+	static std::vector<entry> entries;
+	return entries;
+}
+
+state run(const body_type& body, std::size_t iterations) {
+	state s{iterations};
+	body(s);
+	return s;
+}
+
+const char* simd_name(net::simd s) {
+	switch (s) {
+		case net::simd::scalar:
+			return "scalar";
+		case net::simd::sse42:
+			return "sse4.2";
+		case net::simd::avx2:
+			return "avx2";
+		case net::simd::avx512:
+			return "avx512f";
+	}
+	return "unknown";
+}
+}  // namespace
+
+void state::start() {
+	started_allocations = total_allocations.load(std::memory_order_relaxed);
+	started = std::chrono::steady_clock::now();
+}
+
+void state::stop() {
+	auto stopped = std::chrono::steady_clock::now();
+	allocations = total_allocations.load(std::memory_order_relaxed) -
+				  started_allocations;
+	ns = std::chrono::duration<double, std::nano>(stopped - started).count();
+}
+
+void add(std::string name, body_type body) {
+	registry().push_back({std::move(name), std::move(body)});
+}
+}  // namespace bench
+
+// usage: benchmarks [--filter substring] [--min-time seconds]
+// [--repetitions count]
+// results are written to stdout as JSON, every benchmark runs at least
+// min-time seconds and the fastest of repetitions is reported
+int main(int argc, char** argv) {
+	const char* filter = "";
+	double min_time = 0.2;
+	int repetitions = 3;
+	for (int i = 1; i + 1 < argc; i += 2) {
+		if (not std::strcmp(argv[i], "--filter")) {
+			filter = argv[i + 1];
+		} else if (not std::strcmp(argv[i], "--min-time")) {
+			min_time = std::atof(argv[i + 1]);
+		} else if (not std::strcmp(argv[i], "--repetitions")) {
+			repetitions = std::max(std::atoi(argv[i + 1]), 1);
+		} else {
+			std::fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	auto& entries = bench::registry();
+	std::sort(entries.begin(), entries.end(),
+			  [](const auto& a, const auto& b) { return a.name < b.name; });
+
+	std::printf("{\n");
+	std::printf("  \"context\": {\"simd\": \"%s\", \"hardware_threads\": %u},\n",
+				bench::simd_name(net::simd_best()),
+				std::thread::hardware_concurrency());
+	std::printf("  \"benchmarks\": [");
+
+	const char* separator = "\n";
+	for (const auto& e : entries) {
+		if (e.name.find(filter) == std::string::npos)
+			continue;
+
+		// warm up and grow iterations up to tenth of min_time
+		const double target = min_time * 1e9;
+		auto m = bench::run(e.body, 1);
+		while (m.ns < target / 10 && m.iterations < (std::size_t{1} << 40)) {
+			m = bench::run(e.body, m.iterations * 10);
+		}
+
+		auto iterations = std::max<std::size_t>(
+			m.iterations, static_cast<std::size_t>(
+							  target / std::max(m.ns / m.iterations, 1e-3)));
+		auto best = bench::run(e.body, iterations);
+		for (int r = 1; r < repetitions; ++r) {
+			auto o = bench::run(e.body, iterations);
+			if (o.ns < best.ns)
+				best = o;
+		}
+
+		const auto ops =
+			static_cast<double>(best.iterations * best.ops_per_iteration);
+		std::printf(
+			"%s    {\"name\": \"%s\", \"iterations\": %zu, "
+			"\"ns_per_op\": %.3f, \"allocs_per_op\": %.3f}",
+			separator, e.name.c_str(), best.iterations, best.ns / ops,
+			static_cast<double>(best.allocations) / ops);
+		std::fflush(stdout);
+		separator = ",\n";
+	}
+	std::printf("\n  ]\n}\n");
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
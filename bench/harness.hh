@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace bench {
+// state of one run of benchmark
+// only the loop over state is measured, so setup before it isn't counted:
+//   for (auto _ : state) { ... }
+class state {
+   public:
+	explicit state(std::size_t iterations_) : iterations(iterations_) {}
+
+	struct iterator {
+		state* s;
+		std::size_t left;
+
+		bool operator!=(const iterator&) {
+			if (left != 0)
+				return true;
+			s->stop();
+			return false;
+		}
+		iterator& operator++() {
+			--left;
+			return *this;
+		}
+		// variable of loop is never used, so its type is marked
+		struct [[maybe_unused]] value {};
+		value operator*() const { return {}; }
+	};
+
+	iterator begin() {
+		start();
+		return {this, iterations};
+	}
+	iterator end() { return {this, 0}; }
+
+	// number of iterations of loop
+	std::size_t iterations;
+	// number of operations done by each iteration (e.g. samples of batch)
+	std::size_t ops_per_iteration = 1;
+
+	// measured time in nanoseconds and number of allocations
+	double ns = 0;
+	std::size_t allocations = 0;
+
+   private:
+	void start();
+	void stop();
+
+	std::chrono::steady_clock::time_point started;
+	std::size_t started_allocations = 0;
+};
+
+// benchmark body
+using body_type = std::function<void(state&)>;
+
+// register benchmark @name@
+void add(std::string name, body_type body);
+
+// registers benchmark at static initialization
+struct registrar {
+	registrar(std::string name, body_type body) {
+		add(std::move(name), std::move(body));
+	}
+};
+
+// prevent compiler from optimizing away computing of @value@
+template <typename T>
+inline void keep(const T& value) {
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// prevent compiler from assuming anything about memory
+inline void clobber() {
+	asm volatile("" : : : "memory");
+}
+}  // namespace bench
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+
+// register benchmark @name@ with body taking state
+#define BENCHMARK(name, ...)                                      \
+	static ::bench::registrar BENCH_CONCAT(bench_registrar_, __LINE__) { \
+		name, __VA_ARGS__                                         \
+	}
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,153 @@
+#include <filesystem>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Net.hh>
+
+#include "harness.hh"
+
+namespace {
+using net_type = net::Net<net::SimpleNet<16, 32, 4>>;
+
+// score of networks closest to 0 is the best one
+net_type::score_type score(const net_type::result_type& res) {
+	return res[0] - res[1];
+}
+
+net_type population(std::size_t to_use) {
+	net_type n(to_use, to_use / 4);
+	n.seed(1).rand();
+	return n;
+}
+
+net_type::feed_type input(std::size_t sample = 0) {
+	net_type::feed_type in;
+	for (std::size_t i = 0; i < in.size(); ++i) {
+		in[i] = static_cast<float>((sample * 7 + i) % 13) * 0.125f - 1.f;
+	}
+	return in;
+}
+
+// one operation is feeding of whole population
+void feed(bench::state& state, std::size_t to_use) {
+	auto n = population(to_use);
+	auto in = input();
+	for (auto _ : state) {
+		n.feed(in).count_score(score);
+	}
+	bench::keep(n.best_score());
+}
+
+// one operation is feeding of whole population of @to_use@ networks of
+// type T by @threads@ threads
+template <typename T>
+void feed_threads(bench::state& state, std::size_t to_use,
+				  std::size_t threads) {
+	net::Net<T> n(to_use, to_use / 4);
+	n.seed(1).rand().use_threads(threads);
+	typename T::feed_type in;
+	for (std::size_t i = 0; i < in.size(); ++i) {
+		in[i] = static_cast<float>(i % 13) * 0.125f - 1.f;
+	}
+	for (auto _ : state) {
+		n.feed(in).count_score(
+			[](const typename T::result_type& res) { return res[0]; });
+	}
+	bench::keep(n.best_score());
+}
+
+void next(bench::state& state, std::size_t to_use) {
+	auto n = population(to_use);
+	n.feed(input()).count_score(score);
+	for (auto _ : state) {
+		n.next();
+	}
+	bench::keep(n.best_score());
+}
+
+// one operation is one network computed over one sample, racing drops
+// networks early, so it does less work for same operations
+void evaluate(bench::state& state, std::size_t threads, bool race = false) {
+	constexpr std::size_t samples = 256;
+	auto n = population(16);
+	n.use_threads(threads);
+
+	std::vector<net_type::feed_type> in(samples);
+	for (std::size_t s = 0; s < samples; ++s) {
+		in[s] = input(s);
+	}
+
+	state.ops_per_iteration =
+		samples * (n.weights().size() / net_type::net_stride);
+	for (auto _ : state) {
+		n.reset_score();
+		auto fn = [](const net_type::result_type& res, std::size_t) {
+			return res[0];
+		};
+		if (race) {
+			n.race(in, fn, 16);
+		} else {
+			n.evaluate(in, fn);
+		}
+	}
+	bench::keep(n.best_score());
+}
+
+void checkpoint(bench::state& state, bool load) {
+	auto path = std::filesystem::temp_directory_path() /
+				("net_bench_" + std::to_string(::getpid()));
+	auto n = population(32);
+	n.save(path);
+	for (auto _ : state) {
+		if (load) {
+			bench::keep(net_type::load(path).best_score());
+		} else {
+			n.save(path);
+		}
+	}
+	std::filesystem::remove(path);
+}
+
+// populations of 8, 32 and 96 networks used for next generation
+const bool populations = [] {
+	for (std::size_t to_use : {8, 32, 96}) {
+		auto suffix = "/to_use:" + std::to_string(to_use);
+		bench::add("net/feed_count_score" + suffix,
+				   [to_use](bench::state& s) { feed(s, to_use); });
+		bench::add("net/next" + suffix,
+				   [to_use](bench::state& s) { next(s, to_use); });
+	}
+	return true;
+}();
+
+// thread scaling of evaluate(), and of feed() and count_score() for xor
+// and wide topologies
+const bool scaling = [] {
+	std::set<std::size_t> counts{1, 2, 4};
+	counts.insert(std::max(std::thread::hardware_concurrency(), 1u));
+	for (auto threads : counts) {
+		auto suffix = "/threads:" + std::to_string(threads);
+		bench::add("net/evaluate" + suffix,
+				   [threads](bench::state& s) { evaluate(s, threads); });
+		bench::add("net/feed_count_score/xor" + suffix,
+				   [threads](bench::state& s) {
+					   feed_threads<net::SimpleNet<2, 4, 1>>(s, 32, threads);
+				   });
+		bench::add("net/feed_count_score/wide" + suffix,
+				   [threads](bench::state& s) {
+					   feed_threads<net::SimpleNet<64, 256, 64>>(s, 8,
+																 threads);
+				   });
+	}
+	return true;
+}();
+}  // namespace
+
+BENCHMARK("net/race/threads:1", [](bench::state& s) { evaluate(s, 1, true); });
+BENCHMARK("net/checkpoint/save",
+		  [](bench::state& s) { checkpoint(s, false); });
+BENCHMARK("net/checkpoint/load", [](bench::state& s) { checkpoint(s, true); });
+
+// vim: set ts=4 sw=4 :
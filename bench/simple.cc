@@ -0,0 +1,233 @@
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Net.hh>
+
+#include "harness.hh"
+#include "small_net.hh"
+
+namespace {
+using small_type = net::SimpleNet<8, 16, 4>;
+using wide_type = net::SimpleNet<64, 256, 64>;
+using deep_type = net::SimpleNet<16, 16, 16, 16, 16, 16, 16, 16, 4>;
+using dense_wide_type = net::DenseNet<64, 256, 64>;
+using relu_wide_type =
+	net::ActivatedSimpleNet<float, net::activations<net::relu, net::identity>,
+							64, 256, 64>;
+
+// randomized network, seeded so every run computes same data
+template <typename T>
+const T& network() {
+	static const T n = [] {
+		net::random_engine gen{1};
+		T o;
+		o.rand(gen);
+		return o;
+	}();
+	return n;
+}
+
+template <typename T>
+typename T::feed_type input() {
+	typename T::feed_type in;
+	for (std::size_t i = 0; i < in.size(); ++i) {
+		in[i] = static_cast<float>(i % 16) * 0.125f - 1.f;
+	}
+	return in;
+}
+
+template <typename T>
+void proccess(bench::state& state) {
+	const auto& n = network<T>();
+	auto in = input<T>();
+	for (auto _ : state) {
+		bench::clobber();
+		bench::keep(n(in));
+	}
+}
+
+// one operation is one sample of batch
+template <typename T>
+void proccess_batch(bench::state& state) {
+	constexpr std::size_t samples = 256;
+	const auto& n = network<T>();
+	std::vector<typename T::feed_type> in(samples, input<T>());
+	std::vector<typename T::result_type> out(samples);
+	std::vector<float> workspace(T::workspace_size);
+
+	state.ops_per_iteration = samples;
+	for (auto _ : state) {
+		n.proccess_batch(in.data()->data(), samples, out.data()->data(),
+						 workspace.data());
+		bench::clobber();
+	}
+}
+
+// one operation is one sample of batch computed through both layers of
+// wide network by layer kernels of instruction set @s@, so vector kernels
+// are compared with scalar one
+void proccess_batch_simd(bench::state& state, net::simd s) {
+	using first = net::LayerKernel<64, 256>;
+	using second = net::LayerKernel<256, 64>;
+	constexpr std::size_t samples = 16;
+	const auto& n = network<wide_type>();
+	const auto* data = n.weights().data();
+	std::vector<float> in(64 * samples), hidden(256 * samples),
+		out(64 * samples);
+	for (std::size_t i = 0; i < in.size(); ++i) {
+		in[i] = static_cast<float>(i % 16) * 0.125f - 1.f;
+	}
+	auto k1 = first::get(s);
+	auto k2 = second::get(s);
+
+	state.ops_per_iteration = samples;
+	for (auto _ : state) {
+		k1(data, in.data(), samples, hidden.data());
+		k2(data + first::stride * 256, hidden.data(), samples, out.data());
+		bench::clobber();
+	}
+}
+
+// network written by bench_export (same data as network<small_type>())
+void exported(bench::state& state) {
+	std::array<float, small_net::in_size> in;
+	auto feed = input<small_type>();
+	std::copy(feed.begin(), feed.end(), in.begin());
+	for (auto _ : state) {
+		bench::clobber();
+		bench::keep(small_net::evaluate(in));
+	}
+}
+
+void quantized(bench::state& state) {
+	const auto& n = network<small_type>();
+	std::vector<small_type::feed_type> samples(64);
+	net::random_engine gen{4};
+	std::uniform_real_distribution<float> rand(-1.f, 1.f);
+	for (auto& s : samples) {
+		for (auto& v : s)
+			v = rand(gen);
+	}
+	net::QuantizedNet<8, 16, 4> q(n, samples);
+	auto in = input<small_type>();
+	for (auto _ : state) {
+		bench::clobber();
+		bench::keep(q(in));
+	}
+}
+
+// wide network with 90% of weights pruned
+void sparse(bench::state& state) {
+	using sparse_type = net::SparseNet<64, 256, 64>;
+	const auto& n = network<wide_type>();
+	sparse_type s(n, sparse_type::threshold_for(n, 0.9));
+	auto in = input<wide_type>();
+	for (auto _ : state) {
+		bench::clobber();
+		bench::keep(s(in));
+	}
+}
+
+template <typename T>
+void merge(bench::state& state) {
+	net::random_engine gen{2};
+	const auto& a = network<T>();
+	T b;
+	b.rand(gen);
+	for (auto _ : state) {
+		bench::keep(a.merge(b, gen));
+	}
+}
+
+template <typename T, net::crossover_type type>
+void crossover(bench::state& state) {
+	net::random_engine gen{2};
+	const auto& a = network<T>();
+	T b, child;
+	b.rand(gen);
+	for (auto _ : state) {
+		child.crossover(a, b, gen, type);
+		bench::clobber();
+	}
+}
+
+template <typename T>
+void mutation(bench::state& state) {
+	net::random_engine gen{3};
+	T n{network<T>()};
+	for (auto _ : state) {
+		n.mutation(1, gen);
+		bench::clobber();
+	}
+}
+
+template <typename T>
+void stream_save(bench::state& state) {
+	const auto& n = network<T>();
+	std::ostringstream s;
+	for (auto _ : state) {
+		s.seekp(0);
+		s << n;
+		bench::clobber();
+	}
+}
+
+template <typename T>
+void stream_load(bench::state& state) {
+	std::ostringstream saved;
+	saved << network<T>();
+	std::istringstream s(saved.str());
+	T n;
+	for (auto _ : state) {
+		s.seekg(0);
+		s >> n;
+		bench::clobber();
+	}
+}
+// kernels of every instruction set supported by current CPU
+const bool simd_kernels = [] {
+	const std::pair<net::simd, const char*> sets[] = {
+		{net::simd::scalar, "scalar"},
+		{net::simd::sse42, "sse4.2"},
+		{net::simd::avx2, "avx2"},
+		{net::simd::avx512, "avx512f"}};
+	for (auto [s, name] : sets) {
+		if (not net::simd_supported(s))
+			continue;
+		bench::add(std::string("simple/proccess_batch/wide/simd:") + name,
+				   [s](bench::state& st) { proccess_batch_simd(st, s); });
+	}
+	return true;
+}();
+}  // namespace
+
+BENCHMARK("simple/proccess/small", proccess<small_type>);
+BENCHMARK("simple/proccess/wide", proccess<wide_type>);
+BENCHMARK("simple/proccess/deep", proccess<deep_type>);
+BENCHMARK("simple/proccess_batch/small", proccess_batch<small_type>);
+BENCHMARK("simple/proccess_batch/wide", proccess_batch<wide_type>);
+BENCHMARK("simple/proccess_batch/deep", proccess_batch<deep_type>);
+BENCHMARK("simple/proccess_batch/wide_relu", proccess_batch<relu_wide_type>);
+BENCHMARK("dense/proccess/wide", proccess<dense_wide_type>);
+BENCHMARK("dense/proccess_batch/wide", proccess_batch<dense_wide_type>);
+BENCHMARK("dense/crossover/two_point/wide",
+		  crossover<dense_wide_type, net::crossover_type::two_point>);
+BENCHMARK("dense/mutation/wide", mutation<dense_wide_type>);
+BENCHMARK("simple/exported/small", exported);
+BENCHMARK("simple/quantized/small", quantized);
+BENCHMARK("simple/sparse/wide", sparse);
+BENCHMARK("simple/merge/small", merge<small_type>);
+BENCHMARK("simple/merge/wide", merge<wide_type>);
+BENCHMARK("simple/crossover/two_point/wide",
+		  crossover<wide_type, net::crossover_type::two_point>);
+BENCHMARK("simple/crossover/uniform/wide",
+		  crossover<wide_type, net::crossover_type::uniform>);
+BENCHMARK("simple/crossover/blend/wide",
+		  crossover<wide_type, net::crossover_type::blend>);
+BENCHMARK("simple/mutation/wide", mutation<wide_type>);
+BENCHMARK("simple/stream_save/wide", stream_save<wide_type>);
+BENCHMARK("simple/stream_load/wide", stream_load<wide_type>);
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,121 @@
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+#include <Net.hh>
+
+// value of activation A
+template <typename A>
+float activate(float x) {
+	A::apply(x);
+	return x;
+}
+
+// check every supported kernel with activation A gives same bits as scalar
+// kernel
+template <typename kernel>
+void check_kernels(std::size_t data_size, std::size_t in_size,
+				   std::size_t out_size) {
+	constexpr std::size_t n = 21;
+
+	std::mt19937 gen{static_cast<unsigned>(data_size)};
+	std::uniform_real_distribution<float> rand(-4.f, 4.f);
+
+	std::vector<float> data(data_size);
+	std::vector<float> in(in_size * n);
+	for (auto& v : data)
+		v = rand(gen);
+	for (auto& v : in)
+		v = rand(gen);
+
+	std::vector<float> expected(out_size * n);
+	kernel::scalar(data.data(), in.data(), n, expected.data());
+
+	for (auto s : {net::simd::sse42, net::simd::avx2, net::simd::avx512}) {
+		if (not net::simd_supported(s))
+			continue;
+
+		std::vector<float> out(out_size * n);
+		kernel::get(s)(data.data(), in.data(), n, out.data());
+		assert(0 == std::memcmp(out.data(), expected.data(),
+								out.size() * sizeof(float)));
+	}
+}
+
+template <typename A>
+void check_activation() {
+	check_kernels<net::LayerKernel<7, 37, float, A>>(7 * 37 * 2, 7, 37);
+	check_kernels<net::DenseKernel<7, 37, float, A>>(7 * 37 + 37, 7, 37);
+}
+
+int main() {
+	assert(activate<net::identity>(-3.5f) == -3.5f);
+	assert(activate<net::softsign>(1.f) == 0.5f);
+	assert(activate<net::relu>(-2.f) == 0.f);
+	assert(activate<net::relu>(2.f) == 2.f);
+	assert(activate<net::leaky_relu>(-2.f) == -2.f * 0.01f);
+	assert(activate<net::leaky_relu>(2.f) == 2.f);
+	assert(activate<net::hard_tanh>(-5.f) == -1.f);
+	assert(activate<net::hard_tanh>(0.25f) == 0.25f);
+	assert(activate<net::hard_tanh>(5.f) == 1.f);
+
+	// approximations are close to tanh and logistic function and monotonic
+	// (up to rounding near saturation)
+	float previous_tanh = -1.f, previous_sigmoid = 0.f;
+	for (float x = -8.f; x <= 8.f; x += 1.f / 64) {
+		const auto t = activate<net::tanh_approx>(x);
+		const auto s = activate<net::sigmoid_approx>(x);
+		assert(std::abs(t - std::tanh(x)) < 0.009f);
+		assert(std::abs(s - 1.f / (1.f + std::exp(-x))) < 0.0045f);
+		assert(t >= previous_tanh - 1e-6f && s >= previous_sigmoid - 1e-6f);
+		previous_tanh = t;
+		previous_sigmoid = s;
+	}
+
+	check_activation<net::softsign>();
+	check_activation<net::identity>();
+	check_activation<net::relu>();
+	check_activation<net::leaky_relu>();
+	check_activation<net::hard_tanh>();
+	check_activation<net::tanh_approx>();
+	check_activation<net::sigmoid_approx>();
+
+	// each layer uses its activation
+	using relu_type =
+		net::ActivatedSimpleNet<float,
+								net::activations<net::relu, net::identity>, 1,
+								1, 1>;
+	float data[] = {-1.f, 0.f, 2.f, 0.5f};
+	relu_type n{data};
+	assert(n({3.f})[0] == 0.5f);
+	assert(n({-3.f})[0] == 6.5f);
+
+	// same activations are BasicSimpleNet
+	using softsign_type = net::activations<net::softsign, net::softsign>;
+	static_assert(
+		std::is_same_v<net::SimpleNet<2, 3, 1>,
+					   net::ActivatedSimpleNet<float, softsign_type, 2, 3, 1>>);
+
+	// checkpoint keeps activations
+	using net_type = net::Net<net::ActivatedDenseNet<
+		float, net::activations<net::relu, net::tanh_approx>, 2, 3, 1>>;
+	net_type nn(4);
+	nn.seed(1).rand();
+	auto path = std::filesystem::temp_directory_path() /
+				("net_activations_" + std::to_string(::getpid()));
+	nn.save(path);
+	assert(net_type::load(path) == nn);
+	try {
+		net::Net<net::DenseNet<2, 3, 1>>::load(path);
+		return 1;
+	} catch (std::runtime_error& e) {
+	}
+	std::filesystem::remove(path);
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+#include <Net.hh>
+
+// number of calls of operator new
+static std::size_t allocations = 0;
+
+// every form of operator new allocates by malloc() (not by other operator new)
+// and every form of operator delete releases by free()
+static void* allocate(std::size_t size) {
+	++allocations;
+	if (void* p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc{};
+}
+static void* allocate(std::size_t size, std::align_val_t align) {
+	++allocations;
+	auto a = std::max(static_cast<std::size_t>(align), sizeof(void*));
+	if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a))
+		return p;
+	throw std::bad_alloc{};
+}
+
+void* operator new(std::size_t size) {
+	return allocate(size);
+}
+void* operator new[](std::size_t size) {
+	return allocate(size);
+}
+void* operator new(std::size_t size, std::align_val_t align) {
+	return allocate(size, align);
+}
+void* operator new[](std::size_t size, std::align_val_t align) {
+	return allocate(size, align);
+}
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+void operator delete[](void* p) noexcept {
+	std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept {
+	std::free(p);
+}
+void operator delete[](void* p, std::size_t) noexcept {
+	std::free(p);
+}
+void operator delete(void* p, std::align_val_t) noexcept {
+	std::free(p);
+}
+void operator delete[](void* p, std::align_val_t) noexcept {
+	std::free(p);
+}
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+	std::free(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+	std::free(p);
+}
+
+using simple_type = net::SimpleNet<4, 16, 8, 3>;
+using net_type = net::Net<net::SimpleNet<2, 3, 2>>;
+
+int main() {
+	simple_type sn;
+	sn.rand();
+
+	net_type n(5);
+	n.rand();
+
+	simple_type::feed_type sdata{1.f, 2.f, 3.f, 4.f};
+	simple_type::result_type sres;
+	net_type::feed_type ndata{0.f, 1.f};
+
+	[[maybe_unused]] auto before = allocations;
+
+	for (int i = 0; i < 100; ++i) {
+		sres = sn(sdata);
+		sn.proccess(sdata.data(), sres.data());
+
+		n.feed(ndata);
+		n.count_score([](const net_type::result_type& res) { return res[0]; });
+	}
+
+	// inference must not touch heap
+	assert(allocations == before);
+
+	// copying of array must not touch heap
+	simple_type::feed_type copy{sdata};
+	assert(copy[3] == sdata[3]);
+	assert(allocations == before);
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
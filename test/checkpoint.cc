@@ -0,0 +1,114 @@
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <Net.hh>
+
+using net_type = net::Net<net::SimpleNet<2, 5, 2>>;
+
+// return score for expected true result
+net_type::score_type check_true(const net_type::result_type& res) {
+	return res[0] - res[1];
+};
+
+int main() {
+	auto path = std::filesystem::temp_directory_path() /
+				("net_checkpoint_" + std::to_string(::getpid()));
+
+	net_type n(6, 2);
+	n.seed(3).rand().use_crossover(net::crossover_type::uniform);
+	n.feed({1.f, 0.f}).count_score(check_true);
+	n.save(path);
+
+	auto loaded = net_type::load(path, true);
+	assert(loaded == n);
+	assert(loaded.score() == n.score());
+	assert(loaded.best_score() == n.best_score());
+
+	// data of networks is aligned in mapped file
+	assert(reinterpret_cast<std::uintptr_t>(loaded.weights().data()) %
+			   net_type::arena_align ==
+		   0);
+
+	// generator state and settings are restored
+	n.next();
+	loaded.next();
+	assert(loaded == n);
+
+	// mapped checkpoint can be overwritten
+	loaded.save(path);
+	assert(net_type::load(path) == loaded);
+
+	// other topology
+	try {
+		net::Net<net::SimpleNet<2, 4, 2>>::load(path);
+		return 1;
+	} catch (std::runtime_error& e) {
+	}
+
+	// corrupted data of networks
+	{
+		std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+		f.seekp(-1, std::ios::end);
+		f.put('\x7f');
+	}
+	net_type::load(path);
+	try {
+		net_type::load(path, true);
+		return 1;
+	} catch (std::runtime_error& e) {
+	}
+
+	// corrupted header
+	{
+		std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+		f.seekp(20);
+		f.put('\x7f');
+	}
+	try {
+		net_type::load(path);
+		return 1;
+	} catch (std::runtime_error& e) {
+	}
+
+	// numbers of networks overflowing sizes of sections (checksum is valid)
+	n.save(path);
+	{
+		std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+		auto get = [&f](std::streamoff at) {
+			std::uint64_t v;
+			f.seekg(at);
+			f.read(reinterpret_cast<char*>(&v), sizeof(v));
+			return v;
+		};
+		auto set = [&f](std::streamoff at, std::uint64_t v) {
+			f.seekp(at);
+			f.write(reinterpret_cast<const char*>(&v), sizeof(v));
+		};
+
+		// offsets of nets_size, immutable, weights_offset and checksum
+		constexpr std::streamoff nets = 40, immutable = 56, offset = 88,
+								 sum = 104;
+		constexpr auto big = std::uint64_t{1} << 62;
+		set(nets, get(nets) + big);
+		set(immutable, get(immutable) + big);
+		set(sum, 0);
+		std::vector<char> meta(get(offset));
+		f.seekg(0);
+		f.read(meta.data(), meta.size());
+		set(sum, net::checksum(meta.data(), meta.size()));
+	}
+	try {
+		net_type::load(path);
+		return 1;
+	} catch (std::runtime_error& e) {
+	}
+
+	std::filesystem::remove(path);
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
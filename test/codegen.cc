@@ -0,0 +1,90 @@
+#include <cassert>
+#include <sstream>
+
+#include <Net.hh>
+#include <exported_net.hh>
+
+// same networks as written by codegen_export
+using net_type = net::SimpleNet<8, 16, 4>;
+using activated_type =
+	net::ActivatedSimpleNet<float,
+							net::activations<net::identity, net::relu,
+											 net::leaky_relu, net::hard_tanh,
+											 net::tanh_approx,
+											 net::sigmoid_approx>,
+							8, 16, 12, 10, 8, 6, 4>;
+
+// evaluate() can be computed at compile time
+constexpr auto constant = exported::evaluate({1, 0, 0, 1, 0, 1, 1, 0});
+
+int main() {
+	static_assert(exported::in_size == net_type::in_size);
+	static_assert(exported::out_size == net_type::out_size);
+
+	net::random_engine gen{7};
+	net_type n;
+	n.rand(gen);
+	n.mutation(100, gen);
+
+	// data is exported exactly
+	std::size_t offset = 0;
+	for (auto v : exported::layer0) {
+		assert(v == n.weights()[offset++]);
+	}
+	for (auto v : exported::layer1) {
+		assert(v == n.weights()[offset++]);
+	}
+	assert(offset == net_type::data_size);
+
+	std::uniform_real_distribution<float> rand(-4.f, 4.f);
+	for (int s = 0; s < 100; ++s) {
+		net_type::feed_type in;
+		std::array<float, exported::in_size> x;
+		for (std::size_t i = 0; i < in.size(); ++i) {
+			x[i] = in[i] = rand(gen);
+		}
+		auto expected = n(in);
+		auto res = exported::evaluate(x);
+		for (std::size_t i = 0; i < res.size(); ++i) {
+			assert(std::abs(res[i] - expected[i]) < 1e-6f);
+		}
+	}
+
+	auto expected = n({1, 0, 0, 1, 0, 1, 1, 0});
+	for (std::size_t i = 0; i < constant.size(); ++i) {
+		assert(std::abs(constant[i] - expected[i]) < 1e-6f);
+	}
+
+	// activation of each layer is exported
+	{
+		net::random_engine agen{8};
+		activated_type a;
+		a.rand(agen);
+		a.mutation(100, agen);
+		for (int s = 0; s < 100; ++s) {
+			activated_type::feed_type in;
+			std::array<float, activated::in_size> x;
+			for (std::size_t i = 0; i < in.size(); ++i) {
+				x[i] = in[i] = rand(gen);
+			}
+			auto expected = a(in);
+			auto res = activated::evaluate(x);
+			for (std::size_t i = 0; i < res.size(); ++i) {
+				assert(std::abs(res[i] - expected[i]) < 1e-6f);
+			}
+		}
+	}
+
+	// networks with infinite data can't be exported
+	float storage[net::SimpleNet<2, 2>::data_size] = {INFINITY};
+	std::ostringstream s;
+	try {
+		net::SimpleNet<2, 2>{storage}.save_header(s, "broken");
+		return 1;
+	} catch (std::invalid_argument& e) {
+	}
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,35 @@
+#include <Net.hh>
+
+// networks exported by this program are compiled into test codegen
+using net_type = net::SimpleNet<8, 16, 4>;
+using activated_type =
+	net::ActivatedSimpleNet<float,
+							net::activations<net::identity, net::relu,
+											 net::leaky_relu, net::hard_tanh,
+											 net::tanh_approx,
+											 net::sigmoid_approx>,
+							8, 16, 12, 10, 8, 6, 4>;
+
+int main(int argc, char** argv) {
+	if (argc != 2)
+		return 1;
+
+	net::random_engine gen{7};
+	net_type n;
+	n.rand(gen);
+	n.mutation(100, gen);
+	net::random_engine agen{8};
+	activated_type a;
+	a.rand(agen);
+	a.mutation(100, agen);
+
+	std::ofstream f(argv[1], std::ios::trunc);
+	n.save_header(f, "exported");
+	a.save_header(f, "activated");
+	if (not f)
+		return 1;
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,75 @@
+#include <cassert>
+#include <sstream>
+
+#include <Net.hh>
+
+using simple_type = net::SimpleNet<3, 40, 2>;
+
+// check every value of child is taken from one of parents
+void check_taken(const simple_type& child, const simple_type& a,
+				 const simple_type& b) {
+	std::stringstream sc, sa, sb;
+	sc << child;
+	sa << a;
+	sb << b;
+	for (std::size_t i = 0; i < simple_type::data_size; ++i) {
+		net::store_type vc, va, vb;
+		sc.read(reinterpret_cast<char*>(&vc), sizeof(vc));
+		sa.read(reinterpret_cast<char*>(&va), sizeof(va));
+		sb.read(reinterpret_cast<char*>(&vb), sizeof(vb));
+		assert(vc == va || vc == vb);
+	}
+}
+
+int main() {
+	net::xoshiro256pp gen{1};
+
+	simple_type a, b, child;
+	a.rand(gen);
+	b.rand(gen);
+
+	for (auto type :
+		 {net::crossover_type::two_point, net::crossover_type::uniform,
+		  net::crossover_type::multi_point}) {
+		child.crossover(a, b, gen, type, 7);
+		check_taken(child, a, b);
+	}
+
+	// same parents give same child
+	for (auto type :
+		 {net::crossover_type::two_point, net::crossover_type::uniform,
+		  net::crossover_type::multi_point, net::crossover_type::blend}) {
+		child.crossover(a, a, gen, type);
+		assert(child == a);
+	}
+
+	// child can be one of parents
+	child = a;
+	child.crossover(child, b, gen, net::crossover_type::uniform);
+	check_taken(child, a, b);
+
+	// generator of 32 bits chooses every value of uniform crossover
+	{
+		std::mt19937 gen32{3};
+		std::size_t from_b[64] = {};
+		for (int k = 0; k < 100; ++k) {
+			child.crossover(a, b, gen32, net::crossover_type::uniform);
+			for (std::size_t i = 0; i < simple_type::data_size; ++i) {
+				if (child.weights()[i] != a.weights()[i])
+					++from_b[i % 64];
+			}
+		}
+		for (auto count : from_b) {
+			assert(count > 0);
+		}
+	}
+
+	// breeding in place is used by next()
+	net::Net<simple_type> n(4);
+	n.seed(2).rand().use_crossover(net::crossover_type::blend).next();
+	n.use_crossover(net::crossover_type::multi_point, 3).next();
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
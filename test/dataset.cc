@@ -0,0 +1,143 @@
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <Net.hh>
+
+using net_type = net::Net<net::SimpleNet<2, 3, 1>>;
+using dataset_type = net::Dataset<2, 1>;
+
+int main() {
+	auto dir = std::filesystem::temp_directory_path();
+	auto path = dir / ("net_dataset_" + std::to_string(::getpid()));
+	auto csv = dir / ("net_dataset_" + std::to_string(::getpid()) + ".csv");
+
+	// xor samples repeated, label is expected result
+	constexpr std::size_t samples = 1000;
+	std::vector<dataset_type::feed_type> in(samples);
+	std::vector<net::store_type> labels(samples);
+	for (std::size_t i = 0; i < samples; ++i) {
+		in[i] = dataset_type::feed_type{float(i & 1), float((i >> 1) & 1)};
+		labels[i] = float((i & 1) ^ ((i >> 1) & 1));
+	}
+	dataset_type::write(path, in, labels);
+
+	{
+		dataset_type data(path, 64);
+		assert(data.size() == samples);
+		assert(data.blocks() == (samples + 63) / 64);
+
+		auto all = data.all();
+		assert(all.size() == samples);
+		for (std::size_t i = 0; i < samples; ++i) {
+			assert(all.inputs[i][0] == in[i][0]);
+			assert(all.inputs[i][1] == in[i][1]);
+			assert(all.labels(i)[0] == labels[i]);
+		}
+
+		// last block is shorter
+		auto last = data.block(data.blocks() - 1);
+		assert(last.size() == samples % 64);
+		assert(last.first + last.size() == samples);
+
+		// shuffled minibatches cover all samples
+		net::xoshiro256pp gen{1};
+		data.shuffle(gen);
+		std::size_t covered = 0;
+		for (std::size_t i = 0; i < data.blocks(); ++i) {
+			auto b = data.minibatch(i);
+			for (std::size_t s = 0; s < b.size(); ++s) {
+				assert(b.inputs[s][0] == in[b.first + s][0]);
+				assert(b.labels(s)[0] == labels[b.first + s]);
+			}
+			covered += b.size();
+		}
+		assert(covered == samples);
+
+		// samples are used by Net without copying
+		net_type n(5);
+		n.rand();
+		auto view = data.block(0);
+		n.evaluate(view.inputs,
+				   [&view](const net_type::result_type& res, std::size_t s) {
+					   return -std::abs(res[0] - view.labels(s)[0]);
+				   });
+	}
+
+	// CSV conversion
+	{
+		std::ofstream f(csv);
+		f << "0,0,0\n0, 1, 1\n1,0,1\r\n\n1,1,0\n";
+	}
+	dataset_type::convert_csv(csv, path);
+	{
+		dataset_type data(path);
+		assert(data.size() == 4);
+		auto all = data.all();
+		assert(all.inputs[1][1] == 1.f);
+		assert(all.labels(2)[0] == 1.f);
+		assert(all.labels(3)[0] == 0.f);
+	}
+
+	// number of samples overflowing sizes of sections
+	{
+		auto bad = dir / ("net_dataset_bad_" + std::to_string(::getpid()));
+		std::filesystem::copy_file(path, bad);
+		{
+			// samples field follows magic, 4 fields of 32 bit and labels_size
+			std::fstream f(bad, std::ios::in | std::ios::out |
+									std::ios::binary);
+			std::uint64_t count = (std::uint64_t{1} << 62) + 4;
+			f.seekp(32);
+			f.write(reinterpret_cast<const char*>(&count), sizeof(count));
+		}
+		try {
+			dataset_type data(bad);
+			return 1;
+		} catch (std::runtime_error& e) {
+		}
+		std::filesystem::remove(bad);
+	}
+
+	// other type of samples
+	try {
+		net::Dataset<3, 1> data(path);
+		return 1;
+	} catch (std::runtime_error& e) {
+	}
+
+#if NET_HAS_MMAP
+	// rejected files aren't left mapped
+	{
+		auto mappings = [&path] {
+			std::ifstream maps("/proc/self/maps");
+			std::size_t o = 0;
+			for (std::string line; std::getline(maps, line);) {
+				if (line.find(path.filename().string()) != std::string::npos)
+					++o;
+			}
+			return o;
+		};
+		[[maybe_unused]] auto before = mappings();
+		for (int i = 0; i < 3; ++i) {
+			try {
+				net::Dataset<3, 1> data(path);
+				return 1;
+			} catch (std::runtime_error& e) {
+			}
+		}
+		assert(mappings() == before);
+	}
+#endif
+
+	std::filesystem::remove(path);
+	std::filesystem::remove(csv);
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,93 @@
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+
+#include <Net.hh>
+
+using dense_type = net::DenseNet<3, 10, 2>;
+using net_type = net::Net<net::DenseNet<2, 3, 2>>;
+
+// sigmoid used by layers
+float sigmoid(float x) {
+	return x / (1 + std::abs(x));
+}
+
+int main() {
+	// one weight per input and one bias per neuron
+	static_assert(net::DenseNet<2, 3, 1>::data_size == 2 * 3 + 3 + 3 + 1);
+	static_assert(net::DenseNet<64, 64, 8>::data_size * 2 ==
+				  net::SimpleNet<64, 64, 8>::data_size + (64 + 8) * 2);
+
+	// row-major matrix followed by biases
+	{
+		float data[] = {1, 2, -1, 0.5, 0.25, -0.5, 1, 2, -1, 0.5, -1, 0};
+		net::DenseNet<2, 2, 2> n{data};
+		float x0 = sigmoid(0.5f * 1 + 1.f * 2 + 0.25f);
+		float x1 = sigmoid(0.5f * -1 + 1.f * 0.5f + -0.5f);
+		float y0 = sigmoid(x0 * 1 + x1 * 2 + -1);
+		float y1 = sigmoid(x0 * -1 + x1 * 0.5f + 0);
+		auto res = n({0.5f, 1.f});
+		assert(res[0] == y0);
+		assert(res[1] == y1);
+	}
+
+	// batch is same as computing samples one by one (layer of 10 neurons
+	// has full block and tail)
+	{
+		net::random_engine gen{1};
+		dense_type n;
+		n.rand(gen);
+		std::uniform_real_distribution<float> rand(-1.f, 1.f);
+		std::vector<dense_type::feed_type> in(37);
+		for (auto& x : in) {
+			for (auto& v : x) {
+				v = rand(gen);
+			}
+		}
+		std::vector<dense_type::result_type> out(in.size());
+		n.proccess_batch(in, out);
+		for (std::size_t i = 0; i < in.size(); ++i) {
+			auto res = n(in[i]);
+			assert(res[0] == out[i][0] && res[1] == out[i][1]);
+		}
+
+		auto copy = n;
+		assert(copy == n);
+		copy.mutation(1, gen);
+		assert(not(copy == n));
+	}
+
+	// Net of DenseNets learns xor
+	net_type nn(25);
+	nn.seed(2).rand();
+	const net_type::feed_type xor_data_in[4] = {
+		{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+	auto check = [](const net_type::result_type& res, std::size_t sample) {
+		bool expected = sample == 1 || sample == 2;
+		return expected ? res[0] - res[1] : res[1] - res[0];
+	};
+	int generation = 0;
+	for (;; ++generation) {
+		nn.reset_score().evaluate(xor_data_in, check);
+		if (nn.best_score<std::greater>() >= 7.5f)
+			break;
+		assert(generation < 10000);
+		nn.next<std::greater>(5);
+	}
+
+	// checkpoint of DenseNets isn't loaded as SimpleNets
+	auto path = std::filesystem::temp_directory_path() /
+				("net_dense_" + std::to_string(::getpid()));
+	nn.save(path);
+	assert(net_type::load(path) == nn);
+	try {
+		net::Net<net::SimpleNet<2, 3, 2>>::load(path);
+		return 1;
+	} catch (std::runtime_error& e) {
+	}
+	std::filesystem::remove(path);
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
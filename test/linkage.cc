@@ -0,0 +1,32 @@
+#include <cassert>
+
+#include "linkage.hh"
+
+// networks are passed to functions of other translation unit, it fails to link
+// if any type in template arguments of networks has internal linkage
+int main() {
+	net::xoshiro256pp gen{3};
+
+	simple_type simple;
+	simple.rand(gen);
+	assert(first(simple) == simple.proccess({1.f, 2.f})[0]);
+
+	dense_type dense;
+	dense.rand(gen);
+	assert(first(dense) == dense.proccess({1.f, 2.f})[0]);
+
+	std::array<float, relu_type::data_size> data{};
+	relu_type relu{data.data()};
+	relu.rand(gen);
+	assert(first(relu) == relu.proccess({1.f, 2.f})[0]);
+
+	sparse_type sparse(simple, 0);
+	assert(first(sparse) == sparse({1.f, 2.f})[0]);
+
+	nets_type nets(4);
+	assert(count(nets) == nets.size());
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Net.hh>
+
+// networks passed between translation units of test linkage, all of them
+// must have external linkage to be found by linker
+using simple_type = net::SimpleNet<2, 3, 1>;
+using dense_type = net::DenseNet<2, 3, 1>;
+using relu_type =
+	net::ActivatedSimpleNet<float, net::activations<net::relu, net::identity>,
+							2, 3, 1>;
+using sparse_type = net::SparseNet<2, 3, 1>;
+using nets_type = net::Net<simple_type>;
+
+// defined in linkage_other.cc
+float first(const simple_type& n);
+float first(const dense_type& n);
+float first(const relu_type& n);
+float first(const sparse_type& n);
+std::size_t count(const nets_type& nets);
+
+// vim: set ts=4 sw=4 :
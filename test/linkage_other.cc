@@ -0,0 +1,23 @@
+#include "linkage.hh"
+
+float first(const simple_type& n) {
+	return n.proccess({1.f, 2.f})[0];
+}
+
+float first(const dense_type& n) {
+	return n.proccess({1.f, 2.f})[0];
+}
+
+float first(const relu_type& n) {
+	return n.proccess({1.f, 2.f})[0];
+}
+
+float first(const sparse_type& n) {
+	return n({1.f, 2.f})[0];
+}
+
+std::size_t count(const nets_type& nets) {
+	return nets.size();
+}
+
+// vim: set ts=4 sw=4 :
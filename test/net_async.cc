@@ -0,0 +1,99 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include <Net.hh>
+
+using namespace std::literals;
+
+using net_type = net::Net<net::SimpleNet<2, 3, 2>>;
+using network_type = net_type::network_type;
+
+net_type::feed_type xor_in[4] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+
+// score of network over all xor inputs (maximum is 8)
+net_type::score_type xor_score(const network_type& n) {
+	net_type::score_type o = 0;
+	for (std::size_t i = 0; i < 4; ++i) {
+		auto res = n(xor_in[i]);
+		o += (i == 1 || i == 2) ? res[0] - res[1] : res[1] - res[0];
+	}
+	return o;
+}
+
+// score population by same measure as steady_state_async()
+void count_scores(net_type& n) {
+	for (std::size_t i = 0; i < n.size(); ++i) {
+		n.replace(i, n.network(i), xor_score(n.network(i)));
+	}
+}
+
+int main() {
+	// deferred futures are taken in order of start, so evolution is
+	// reproducible
+	auto deferred = [](const network_type& x) {
+		return std::async(std::launch::deferred, xor_score, std::cref(x));
+	};
+	net_type a(6), b(6);
+	a.seed(1).rand();
+	b.seed(1).rand();
+	count_scores(a);
+	count_scores(b);
+	a.steady_state_async<std::greater>(500, deferred, 4, 5);
+	b.steady_state_async<std::greater>(500, deferred, 4, 5);
+	assert(a == b);
+
+	// xor is learned
+	bool learned = false;
+	for (int i = 0; i < 200 && not learned; ++i) {
+		a.steady_state_async<std::greater>(500, deferred, 4, 5);
+		learned = a.best_score<std::greater>() >= 7.5f;
+	}
+	assert(learned);
+
+	// scoring with latency keeps several children in flight
+	net_type n(6);
+	n.seed(2).rand();
+	count_scores(n);
+	auto best = n.best_score<std::greater>();
+
+	std::atomic<int> in_flight{0}, max_in_flight{0}, calls{0};
+	n.steady_state_async<std::greater>(
+		40,
+		[&](const network_type& x) {
+			++calls;
+			int now = ++in_flight;
+			int seen = max_in_flight;
+			while (now > seen &&
+				   not max_in_flight.compare_exchange_weak(seen, now)) {
+			}
+			return std::async(std::launch::async, [&in_flight, &x] {
+				std::this_thread::sleep_for(20ms);
+				auto o = xor_score(x);
+				--in_flight;
+				return o;
+			});
+		},
+		4, 3, 3);
+
+	assert(calls == 40);
+	assert(max_in_flight > 1 && max_in_flight <= 4);
+	assert(n.best_score<std::greater>() >= best);
+
+	// every network keeps score of its data
+	for (std::size_t i = 0; i < n.size(); ++i) {
+		assert(n.score(i) == xor_score(n.network(i)));
+	}
+
+	try {
+		n.steady_state_async(1, deferred, 0);
+		return 1;
+	} catch (std::invalid_argument& e) {
+	}
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,85 @@
+#include <cassert>
+#include <vector>
+
+#include <Net.hh>
+
+using net_type = net::Net<net::SimpleNet<2, 4, 1>>;
+
+// input data variants
+const net_type::feed_type xor_data_in[4] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+
+int main() {
+	constexpr std::size_t to_use = 5, immutable = 2;
+	const std::span<const net_type::feed_type> samples{xor_data_in};
+
+	std::size_t calls = 0;
+	auto check = [&calls](const net_type::result_type& res,
+						  std::size_t sample) {
+		++calls;
+		float expected = sample == 1 || sample == 2 ? 1.f : 0.f;
+		return res[0] - expected;
+	};
+
+	net_type plain(to_use, immutable);
+	plain.seed(1).rand();
+	net_type cached{plain};
+	cached.use_cache();
+
+	for (int g = 0; g < 10; ++g) {
+		calls = 0;
+		plain.reset_score().evaluate(samples, check);
+		const auto plain_calls = calls;
+
+		calls = 0;
+		cached.reset_score().evaluate(samples, check);
+		const auto cached_calls = calls;
+
+		// same scores, networks kept by next() aren't computed again
+		for (std::size_t i = 0; i < plain.size(); ++i) {
+			assert(plain.score(i) == cached.score(i));
+		}
+		if (g == 0) {
+			assert(cached_calls == plain_calls);
+		} else {
+			assert(cached_calls <= plain_calls - (to_use + immutable) * 4);
+		}
+
+		plain.next();
+		cached.next();
+		assert(plain == cached);
+	}
+
+	// networks with cached score aren't raced, survivors have exact score
+	cached.reset_score().race(samples, check, 1, 2.);
+	plain.reset_score().race(samples, check, 1, 2.);
+	assert(plain.best_score() == cached.best_score());
+
+	// all networks are same (zero data), so children without mutations are
+	// same as networks kept by next()
+	net_type same(to_use, immutable);
+	same.use_cache().next(0);
+	calls = 0;
+	same.evaluate(samples, check);
+	assert(calls == (to_use + immutable) * 4);
+	for (std::size_t i = 1; i < same.size(); ++i) {
+		assert(same.score(i) == same.score(0));
+	}
+
+	same.reset_score().next(0);
+	calls = 0;
+	same.evaluate(samples, check);
+	assert(calls == 0);
+	for (std::size_t i = 1; i < same.size(); ++i) {
+		assert(same.score(i) == same.score(0));
+	}
+
+	// cache is dropped by rand()
+	same.rand().reset_score();
+	calls = 0;
+	same.evaluate(samples, check);
+	assert(calls == same.size() * 4);
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,45 @@
+#include <cassert>
+
+#include <Net.hh>
+
+using net_type = net::Net<net::SimpleNet<2, 3, 2>>;
+
+// input data variants
+const net_type::feed_type xor_data_in[4] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+
+// return score for sample
+net_type::score_type check(const net_type::result_type& res,
+						   std::size_t sample) {
+	bool expected = sample == 1 || sample == 2;
+	return expected ? res[0] - res[1] : res[1] - res[0];
+}
+
+int main() {
+	net_type a(10, 2);
+	a.rand();
+
+	net_type b{a};
+	net_type c{a};
+	c.use_threads(3);
+
+	// same score as feed() and count_score() for each sample
+	for (std::size_t s = 0; s < 4; ++s) {
+		a.feed(xor_data_in[s]);
+		a.count_score(
+			[s](const net_type::result_type& res) { return check(res, s); });
+	}
+	b.evaluate(xor_data_in, check);
+	c.evaluate(xor_data_in, [](const net_type::result_type& res,
+							   std::size_t sample, std::size_t) {
+		return check(res, sample);
+	});
+
+	assert(a.score() == b.score());
+	assert(a.best_score() == b.best_score());
+	assert(a.score() == c.score());
+	assert(a.best_score() == c.best_score());
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -1,3 +1,6 @@
+#include <cassert>
+#include <cstdint>
+
 #include <Net.hh>
 
 using net_type = net::Net<net::SimpleNet<2, 2>>;
@@ -28,6 +31,27 @@ int main() {
 	n.best_score<std::less>();
 	n.best_result<std::greater>();
 
+	// best networks are kept by next()
+	auto first_result = [](const net_type::result_type& res) { return res[0]; };
+	n.rand().reset_score().feed(data).count_score(first_result);
+	auto best = n.best_score<std::greater>();
+	n.next<std::greater>();
+	n.reset_score().feed(data).count_score(first_result);
+	assert(n.best_score<std::greater>() >= best);
+
+	// networks are stored in one aligned arena
+	auto w = n.weights();
+	assert(w.size() % net_type::net_stride == 0);
+	assert(reinterpret_cast<std::uintptr_t>(w.data()) % net_type::arena_align ==
+		   0);
+
+	// copy has its own arena with same data
+	net_type copy{n};
+	assert(copy == n);
+	assert(copy.weights().data() != w.data());
+	copy.rand();
+	assert(not(copy == n));
+
 	return 0;
 }
 
@@ -0,0 +1,92 @@
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+#include <Net.hh>
+
+using net_type = net::Net<net::SimpleNet<2, 4, 1>>;
+using islands_type = net::Islands<net_type>;
+
+// input data variants
+const net_type::feed_type xor_data_in[4] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+const std::span<const net_type::feed_type> samples{xor_data_in};
+
+// count score of all networks of island
+void score(net_type& island, std::size_t) {
+	island.reset_score().evaluate(
+		samples, [](const net_type::result_type& res, std::size_t sample) {
+			float expected = sample == 1 || sample == 2 ? 1.f : 0.f;
+			return res[0] - expected;
+		});
+}
+
+// check island @a@ contains network of island @b@
+bool contains(const net_type& a, const net_type& b) {
+	for (std::size_t i = 0; i < a.size(); ++i) {
+		for (std::size_t j = 0; j < b.size(); ++j) {
+			if (0 == std::memcmp(a.network(i).weights().data(),
+								 b.network(j).weights().data(),
+								 net_type::network_type::data_size *
+									 sizeof(net_type::storage_type)))
+				return true;
+		}
+	}
+	return false;
+}
+
+int main() {
+	constexpr std::size_t to_use = 5, immutable = 2;
+
+	// one thread evolves islands one by one: island 0 sends its best network
+	// before island 1 migrates, so migrant of island 0 replaces zero network
+	// of island 1 (random networks are better than zero ones)
+	{
+		islands_type islands(2, to_use, immutable, 1);
+		islands.use_migration(net::migration_topology::ring, 5, 1).seed(1);
+		islands[0].rand();
+		islands.run(4, score);
+		assert(not contains(islands[1], islands[0]));
+		islands.run(1, score);
+		assert(contains(islands[1], islands[0]));
+		assert(islands.generations() == 5);
+	}
+
+	// without migration islands are same as separate Nets
+	{
+		islands_type islands(3, to_use, immutable);
+		islands.use_migration(net::migration_topology::fully_connected, 1000)
+			.seed(2)
+			.rand();
+		std::vector<net_type> separate;
+		for (std::size_t i = 0; i < islands.size(); ++i) {
+			separate.emplace_back(to_use, immutable);
+			separate.back().seed(2 + i).rand();
+		}
+		islands.run(10, score);
+		for (std::size_t i = 0; i < islands.size(); ++i) {
+			for (int g = 0; g < 10; ++g) {
+				score(separate[i], i);
+				separate[i].next();
+			}
+			assert(separate[i] == islands[i]);
+		}
+	}
+
+	// islands evolved concurrently
+	islands_type islands(4, to_use, immutable, 4);
+	islands.use_migration(net::migration_topology::fully_connected, 3, 2)
+		.seed(3)
+		.rand();
+	islands.run(30, score);
+	score(islands[islands.best()], 0);
+	assert(std::isfinite(islands.best_score()));
+	for (std::size_t i = 0; i < islands.size(); ++i) {
+		score(islands[i], i);
+		assert(std::abs(islands.best_score()) <=
+			   std::abs(islands[i].best_score()));
+	}
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
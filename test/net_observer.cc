@@ -0,0 +1,97 @@
+#include <cassert>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <Net.hh>
+
+using net_type = net::Net<net::SimpleNet<2, 4, 2>>;
+
+// return score for expected true result
+net_type::score_type check_true(const net_type::result_type& res) {
+	return res[0] - res[1];
+};
+
+int main() {
+	net_type observed(6, 2);
+	observed.seed(1).rand();
+	net_type plain{observed};
+
+	std::vector<net_type::stats_type> stats;
+	std::ostringstream lines;
+	auto json = net_type::json_lines(lines);
+	observed.use_observer([&](const net_type::stats_type& st) {
+		stats.push_back(st);
+		json(st);
+	});
+
+	for (int i = 0; i < 5; ++i) {
+		for (auto* n : {&observed, &plain}) {
+			n->reset_score();
+			n->feed({1.f, 0.f}).count_score(check_true);
+			n->feed({0.f, 1.f}).count_score(check_true);
+		}
+		auto avg = observed.score();
+		auto best = observed.best_score();
+		observed.next(3);
+		plain.next(3);
+
+		const auto& st = stats.back();
+		assert(st.generation == static_cast<std::uint64_t>(i + 1));
+		assert(st.nets == 6 + 2 + 6 * 3);
+		assert(st.children == 6 * 5 / 2);
+		assert(st.mutations == st.children * 3);
+		assert(std::abs(st.mean - avg) < 1e-5f);
+		assert(st.best == best);
+		assert(st.min <= st.quantiles.front());
+		for (std::size_t q = 1; q < st.quantiles.size(); ++q) {
+			assert(st.quantiles[q - 1] <= st.quantiles[q]);
+		}
+		assert(st.quantiles.back() <= st.max);
+
+		std::uint64_t total = 0;
+		for (auto h : st.histogram)
+			total += h;
+		assert(total == st.nets);
+	}
+
+	// observer doesn't change generations
+	assert(observed == plain);
+
+	// one JSON object for each generation
+	std::istringstream in(lines.str());
+	std::string line;
+	std::size_t count = 0;
+	while (std::getline(in, line)) {
+		assert(line.starts_with("{\"generation\":" + std::to_string(++count)));
+		assert(line.ends_with("}"));
+	}
+	assert(count == stats.size());
+
+	// scores which aren't finite are written as null
+	{
+		std::ostringstream out;
+		net_type::stats_type st;
+		st.min = -INFINITY;
+		st.max = INFINITY;
+		st.mean = NAN;
+		st.quantiles.fill(NAN);
+		net_type::json_lines(out)(st);
+		auto line = out.str();
+		assert(line.find("nan") == std::string::npos);
+		assert(line.find("inf") == std::string::npos);
+		assert(line.find("\"min\":null,\"max\":null,\"mean\":null,\"best\":0,"
+						 "\"quantiles\":[null,null,null,null,null]") !=
+			   std::string::npos);
+	}
+
+	// time is counted only while observer is used
+	observed.use_observer(nullptr);
+	observed.feed({1.f, 0.f}).count_score(check_true).next();
+	assert(stats.size() == 5);
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
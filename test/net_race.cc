@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include <Net.hh>
+
+using net_type = net::Net<net::SimpleNet<2, 6, 1>>;
+
+// indexes of networks ordered by score (closest to 0 first)
+std::vector<std::size_t> order(const net_type& n) {
+	std::vector<std::size_t> o(n.size());
+	for (std::size_t i = 0; i < o.size(); ++i)
+		o[i] = i;
+	std::stable_sort(o.begin(), o.end(), [&](std::size_t a, std::size_t b) {
+		return std::abs(n.score(a)) < std::abs(n.score(b));
+	});
+	return o;
+}
+
+int main() {
+	constexpr std::size_t to_use = 12, immutable = 0;
+	net::random_engine gen{5};
+	std::uniform_real_distribution<float> rand(-1.f, 1.f);
+
+	std::vector<net_type::feed_type> samples(4096);
+	std::vector<float> expected(samples.size());
+	for (std::size_t s = 0; s < samples.size(); ++s) {
+		samples[s] = net_type::feed_type{rand(gen), rand(gen)};
+		expected[s] = samples[s][0] * samples[s][1] > 0 ? 0.5f : -0.5f;
+	}
+
+	net_type full(to_use, immutable);
+	full.seed(6).rand();
+	net_type raced{full};
+
+	std::size_t full_calls = 0, raced_calls = 0;
+	full.evaluate(samples, [&](const net_type::result_type& res,
+							   std::size_t s) {
+		++full_calls;
+		return std::abs(res[0] - expected[s]);
+	});
+	raced.race(
+		samples,
+		[&](const net_type::result_type& res, std::size_t s) {
+			++raced_calls;
+			return std::abs(res[0] - expected[s]);
+		},
+		64, 2.);
+
+	// hopeless networks are dropped early
+	assert(raced_calls * 2 < full_calls);
+
+	// same networks are selected
+	auto a = order(full);
+	auto b = order(raced);
+	std::sort(a.begin(), a.begin() + to_use + immutable);
+	std::sort(b.begin(), b.begin() + to_use + immutable);
+	assert(std::equal(a.begin(), a.begin() + to_use + immutable, b.begin()));
+
+	// survivors have exact score
+	for (std::size_t i = 0; i < to_use + immutable; ++i) {
+		assert(full.score(a[i]) == raced.score(a[i]));
+	}
+
+	// with pool
+	net_type threaded{full};
+	threaded.reset_score().use_threads(3);
+	threaded.race(samples,
+				  [&](const net_type::result_type& res, std::size_t s,
+					  std::size_t) { return std::abs(res[0] - expected[s]); },
+				  64, 2.);
+	auto c = order(threaded);
+	std::sort(c.begin(), c.begin() + to_use + immutable);
+	assert(std::equal(a.begin(), a.begin() + to_use + immutable, c.begin()));
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
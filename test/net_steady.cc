@@ -0,0 +1,92 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <Net.hh>
+
+using namespace std::literals;
+
+using net_type = net::Net<net::SimpleNet<2, 3, 2>>;
+using network_type = net_type::network_type;
+
+net_type::feed_type xor_in[4] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+
+// score of network over all xor inputs (maximum is 8)
+net_type::score_type xor_score(const network_type& n) {
+	net_type::score_type o = 0;
+	for (std::size_t i = 0; i < 4; ++i) {
+		auto res = n(xor_in[i]);
+		o += (i == 1 || i == 2) ? res[0] - res[1] : res[1] - res[0];
+	}
+	return o;
+}
+
+// score population by same measure as steady_state()
+void count_scores(net_type& n) {
+	n.reset_score();
+	for (std::size_t i = 0; i < 4; ++i) {
+		n.feed(xor_in[i]).count_score(
+			[i](const net_type::result_type& res) {
+				return (i == 1 || i == 2) ? res[0] - res[1] : res[1] - res[0];
+			});
+	}
+}
+
+int main() {
+	// without pool evolution is reproducible
+	net_type a(6), b(6);
+	a.seed(1).rand();
+	b.seed(1).rand();
+	count_scores(a);
+	count_scores(b);
+	a.steady_state<std::greater>(500, xor_score, 5);
+	b.steady_state<std::greater>(500, xor_score, 5);
+	assert(a == b);
+
+	// xor is learned
+	bool learned = false;
+	for (int i = 0; i < 200 && not learned; ++i) {
+		a.steady_state<std::greater>(500, xor_score, 5);
+		learned = a.best_score<std::greater>() >= 7.5f;
+	}
+	assert(learned);
+
+	// threads don't wait for each other when scoring takes uneven time
+	net_type n(6);
+	n.seed(2).rand().use_threads(3);
+	count_scores(n);
+	auto best = n.best_score<std::greater>();
+
+	std::vector<std::atomic<std::size_t>> calls(3);
+	n.steady_state<std::greater>(
+		300,
+		[&calls](const network_type& x, std::size_t thread) {
+			if (calls[thread]++ % 7 == 0)
+				std::this_thread::sleep_for(1ms);
+			return xor_score(x);
+		},
+		3, 3);
+
+	std::size_t total = 0;
+	for (auto& c : calls)
+		total += c;
+	assert(total == 300);
+	assert(n.best_score<std::greater>() >= best);
+
+	// every network keeps score of its data
+	for (std::size_t i = 0; i < n.size(); ++i) {
+		assert(n.score(i) == xor_score(n.network(i)));
+	}
+
+	try {
+		n.steady_state(1, xor_score, 2, 0);
+		return 1;
+	} catch (std::invalid_argument& e) {
+	}
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
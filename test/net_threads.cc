@@ -0,0 +1,85 @@
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <Net.hh>
+
+using net_type = net::Net<net::SimpleNet<2, 8, 2>>;
+
+// return score for expected true result
+net_type::score_type check_true(const net_type::result_type& res) {
+	return res[0] - res[1];
+};
+
+int main() {
+	net_type serial(12, 3);
+	serial.rand();
+
+	net_type threaded{serial};
+	threaded.use_threads(4);
+
+	net_type::feed_type data{0.5f, 1.f};
+
+	for (int i = 0; i < 10; ++i) {
+		serial.feed(data).count_score(check_true);
+		threaded.feed(data).count_score(check_true);
+	}
+
+	// threads should compute same results
+	assert(serial.score() == threaded.score());
+	assert(serial.best_score() == threaded.best_score());
+	auto r1 = serial.result();
+	auto r2 = threaded.result();
+	assert(0 == std::memcmp(r1.data(), r2.data(), sizeof(r1)));
+
+	// scorer keeping per-thread state
+	auto pool = std::make_shared<net::ThreadPool>(3);
+	threaded.use_pool(pool);
+
+	std::vector<std::size_t> calls(pool->size());
+	threaded.count_score(
+		[&calls](const net_type::result_type& res, std::size_t thread) {
+			++calls[thread];
+			return res[0];
+		});
+
+	std::size_t total = 0;
+	for (auto c : calls)
+		total += c;
+	assert(total == 12 + 3 + 12 * 6);
+
+	// exception of fn is rethrown when all threads leave fn, either thread
+	// can throw it
+	for (std::size_t thrower : {0, 1}) {
+		std::atomic<int> inside = 0;
+		try {
+			pool->parallel_for(1000, 1, [&](auto, auto, std::size_t thread) {
+				++inside;
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				--inside;
+				if (thread == thrower)
+					throw std::runtime_error{"fn"};
+			});
+			return 1;
+		} catch (const std::runtime_error&) {
+		}
+		assert(inside == 0);
+	}
+
+	// pool can be used after exception
+	std::atomic<std::size_t> sum = 0;
+	pool->parallel_for(100, 7, [&sum](auto b, auto e, auto) { sum += e - b; });
+	assert(sum == 100);
+
+	// pool can be shared by several Nets
+	serial.use_pool(pool);
+	serial.feed(data);
+	threaded.feed(data);
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
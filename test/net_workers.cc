@@ -0,0 +1,114 @@
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include <sys/stat.h>
+
+#include <Net.hh>
+
+using simple_type = net::SimpleNet<2, 4, 1>;
+using net_type = net::Net<simple_type>;
+using workers_type = net::ProcessPool<simple_type>;
+
+// input data variants
+const simple_type::feed_type xor_data_in[4] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+
+// score of network over all samples
+float check(const simple_type& n) {
+	float score = 0;
+	for (std::size_t i = 0; i < 4; ++i) {
+		float expected = i == 1 || i == 2 ? 1.f : 0.f;
+		score += n(xor_data_in[i])[0] - expected;
+	}
+	return score;
+}
+
+int main() {
+	constexpr std::size_t to_use = 6, immutable = 3;
+	net_type nn(to_use, immutable);
+	nn.seed(1).rand();
+
+	// first worker sends answer of batch which isn't in flight before its
+	// answer (socket is its only socket), it's handled as crashed worker
+	{
+		auto marker = std::filesystem::temp_directory_path() /
+					  ("net_workers_lie_" + std::to_string(::getpid()));
+		auto lie = [marker](const simple_type& n) {
+			if (not std::filesystem::exists(marker)) {
+				std::ofstream{marker};
+				for (int fd = 3; fd < 256; ++fd) {
+					struct stat st;
+					if (::fstat(fd, &st) == 0 && S_ISSOCK(st.st_mode)) {
+						std::uint64_t answer[3] = {1000, 1, 0};
+						[[maybe_unused]] auto k =
+							::write(fd, answer, sizeof(answer));
+					}
+				}
+			}
+			return check(n);
+		};
+		workers_type lying(1, lie, 2);
+		nn.reset_score().count_score(lying);
+		for (std::size_t i = 0; i < nn.size(); ++i) {
+			assert(nn.score(i) == check(nn.network(i)));
+		}
+		assert(lying.restarts() == 1);
+		std::filesystem::remove(marker);
+	}
+
+	// batches of 4 networks, 3 batches in flight for each worker
+	workers_type workers(3, check, 4, 3);
+	assert(workers.size() == 3);
+	for (int g = 0; g < 5; ++g) {
+		nn.reset_score().count_score(workers);
+		for (std::size_t i = 0; i < nn.size(); ++i) {
+			assert(nn.score(i) == check(nn.network(i)));
+		}
+		nn.next();
+	}
+	assert(workers.restarts() == 0);
+
+	// first worker scoring network with positive first weight crashes (file
+	// is marker shared by workers), its batches are sent to new worker
+	{
+		auto marker = std::filesystem::temp_directory_path() /
+					  ("net_workers_" + std::to_string(::getpid()));
+		auto crash = [marker](const simple_type& n) {
+			if (n.weights()[0] > 0 && not std::filesystem::exists(marker)) {
+				std::ofstream{marker};
+				::_exit(3);
+			}
+			return check(n);
+		};
+		workers_type crashing(2, crash, 2);
+		nn.reset_score().count_score(crashing);
+		for (std::size_t i = 0; i < nn.size(); ++i) {
+			assert(nn.score(i) == check(nn.network(i)));
+		}
+		assert(crashing.restarts() == 1);
+		std::filesystem::remove(marker);
+	}
+
+	// pools are destroyed in other order than they were created (workers of
+	// second pool hold sockets of first pool)
+	{
+		auto first = std::make_unique<workers_type>(1, check);
+		auto second = std::make_unique<workers_type>(1, check);
+		first.reset();
+		nn.reset_score().count_score(*second);
+		second.reset();
+	}
+
+	// network which always crashes its worker
+	workers_type broken(2, [](const simple_type&) -> float { ::_exit(4); });
+	try {
+		nn.count_score(broken);
+		return 1;
+	} catch (std::runtime_error& e) {
+	}
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,60 @@
+#include <cassert>
+#include <vector>
+
+#include <Net.hh>
+
+using net_type = net::SimpleNet<32, 70, 9, 3>;
+using quantized_type = net::QuantizedNet<32, 70, 9, 3>;
+
+int main() {
+	net::xoshiro256pp gen{5};
+	std::uniform_real_distribution<net::store_type> rand(-1.f, 1.f);
+
+	// weights in range of trained networks
+	net_type n;
+	n.rand(gen);
+	n.mutation(200, gen);
+
+	std::vector<net_type::feed_type> samples(200);
+	for (auto& s : samples) {
+		for (auto& v : s)
+			v = rand(gen);
+	}
+
+	quantized_type q(n, samples);
+
+	// results are close to float network
+	auto err = q.error(n, samples);
+	assert(err.mean < 0.01f);
+	assert(err.max < 0.05f);
+
+	// model is several times smaller
+	assert(q.bytes() * 3 < net_type::data_size * sizeof(net::store_type));
+
+	// every dot product kernel gives same result
+	std::vector<std::uint8_t> x(128);
+	std::vector<std::int8_t> w(128);
+	for (std::size_t i = 0; i < x.size(); ++i) {
+		x[i] = static_cast<std::uint8_t>(255 - i);
+		w[i] = static_cast<std::int8_t>(i % 2 ? -128 + i : 127 - i);
+	}
+	for (std::size_t n : {16, 48, 128}) {
+		auto expected = net::DotKernel::scalar(x.data(), w.data(), n);
+		assert(net::DotKernel::get()(x.data(), w.data(), n) == expected);
+	}
+
+	try {
+		quantized_type bad(n, {});
+		return 1;
+	} catch (std::invalid_argument& e) {
+	}
+	try {
+		q.error(n, {});
+		return 1;
+	} catch (std::invalid_argument& e) {
+	}
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
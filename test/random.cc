@@ -0,0 +1,52 @@
+#include <cassert>
+
+#include <Net.hh>
+
+using simple_type = net::SimpleNet<2, 3, 2>;
+using net_type = net::Net<simple_type>;
+
+int main() {
+	// same seed gives same stream
+	net::xoshiro256pp a{42}, b{42}, c{43};
+	assert(a == b);
+	assert(a() == b());
+	assert(a() != c());
+
+	// jumped stream differs
+	b.jump();
+	assert(a() != b());
+
+	// SimpleNet is reproducible by generator
+	net::xoshiro256pp g1{7}, g2{7};
+	simple_type s1, s2;
+	s1.rand(g1);
+	s2.rand(g2);
+	assert(s1 == s2);
+	s1.mutation(3, g1);
+	s2.mutation(3, g2);
+	assert(s1 == s2);
+	assert(s1.merge(s2, g1) == s2.merge(s1, g2));
+
+	// default generator of thread
+	s1.rand();
+	s1.mutation(2);
+	s1.merge(s2);
+
+	// Net is reproducible by seed
+	net_type n1(5), n2(5);
+	n1.seed(1).rand();
+	n2.seed(1).rand();
+	assert(n1 == n2);
+
+	n1.next(3);
+	n2.next(3);
+	assert(n1 == n2);
+
+	// any generator can be used
+	net::Net<simple_type, std::mt19937_64> n3(5);
+	n3.seed(1).rand().next();
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,139 @@
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+
+#include <Net.hh>
+
+template <typename T>
+void check_conversion() {
+	assert(float(T(0.f)) == 0.f);
+	assert(float(T(1.f)) == 1.f);
+	assert(float(T(-2.5f)) == -2.5f);
+	assert(float(T(T::max)) == T::max);
+	assert(std::isinf(float(T(INFINITY))));
+	assert(std::isnan(float(T(NAN))));
+
+	// rounding is stable and close to value
+	net::random_engine gen{1};
+	std::uniform_real_distribution<float> rand(-100.f, 100.f);
+	for (int i = 0; i < 10000; ++i) {
+		auto x = rand(gen);
+		auto y = float(T(x));
+		assert(T(y) == T(x));
+		assert(std::abs(x - y) <= std::abs(x) / 256);
+	}
+}
+
+template <typename T>
+void check_net() {
+	using simple_type = net::BasicSimpleNet<T, 2, 5, 2>;
+	using float_type = net::SimpleNet<2, 5, 2>;
+	static_assert(std::is_same_v<typename simple_type::value_type,
+								 net::compute_type_t<T>>);
+
+	net::random_engine gen{2};
+	simple_type n;
+	n.rand(gen);
+
+	// same weights computed as float
+	float weights[float_type::data_size];
+	for (std::size_t i = 0; i < float_type::data_size; ++i) {
+		weights[i] = static_cast<float>(n.weights()[i]);
+	}
+	float_type f{weights};
+	auto a = n({0.25f, 0.75f});
+	auto b = f({0.25f, 0.75f});
+	for (std::size_t i = 0; i < a.size(); ++i) {
+		assert(std::abs(a[i] - b[i]) < 1e-5);
+	}
+
+	// blend stays between parents
+	simple_type p1, p2, child;
+	p1.rand(gen);
+	p2.rand(gen);
+	child.crossover(p1, p2, gen, net::crossover_type::blend);
+	for (std::size_t i = 0; i < simple_type::data_size; ++i) {
+		auto lo = std::min(p1.weights()[i], p2.weights()[i]);
+		auto hi = std::max(p1.weights()[i], p2.weights()[i]);
+		assert(lo <= child.weights()[i] && child.weights()[i] <= hi);
+	}
+}
+
+// mutations of narrow storage saturate instead of overflowing
+template <typename T>
+void check_saturation() {
+	using simple_type = net::BasicSimpleNet<T, 2, 2>;
+	T storage[simple_type::data_size];
+	for (auto& v : storage) {
+		v = T(T::max);
+	}
+	simple_type n{storage};
+	net::random_engine gen{3};
+	n.mutation(1000, gen);
+	for (auto v : n.weights()) {
+		assert(std::isfinite(float(v)));
+	}
+}
+
+int main() {
+	check_conversion<net::half>();
+	check_conversion<net::bfloat16>();
+
+	// subnormal half and overflow
+	assert(float(net::half(0x1p-24f)) == 0x1p-24f);
+	assert(float(net::half(0x1p-26f)) == 0.f);
+	assert(std::isinf(float(net::half(65520.f))));
+	assert(float(net::half(65519.f)) == 65504.f);
+
+	static_assert(sizeof(net::half) == 2 && sizeof(net::bfloat16) == 2);
+
+	check_net<double>();
+	check_net<net::half>();
+	check_net<net::bfloat16>();
+	check_saturation<net::half>();
+	check_saturation<net::bfloat16>();
+
+	// population of half networks takes half of memory (when networks
+	// aren't padded)
+	{
+		net::Net<net::BasicSimpleNet<net::half, 4, 8, 4>> h(6, 2);
+		net::Net<net::SimpleNet<4, 8, 4>> f(6, 2);
+		assert(h.weights().size_bytes() * 2 == f.weights().size_bytes());
+	}
+
+	using half_net = net::Net<net::BasicSimpleNet<net::half, 2, 5, 2>>;
+	using float_net = net::Net<net::SimpleNet<2, 5, 2>>;
+	half_net h(6, 2);
+
+	// checkpoint keeps kind of storage
+	auto path = std::filesystem::temp_directory_path() /
+				("net_scalar_types_" + std::to_string(::getpid()));
+	h.seed(4).rand();
+	h.feed({1.f, 0.f}).count_score([](const auto& res) { return res[0]; });
+	h.next();
+	h.save(path);
+	assert(half_net::load(path, true) == h);
+	try {
+		net::Net<net::BasicSimpleNet<net::bfloat16, 2, 5, 2>>::load(path);
+		return 1;
+	} catch (std::runtime_error& e) {
+	}
+	try {
+		float_net::load(path);
+		return 1;
+	} catch (std::runtime_error& e) {
+	}
+	std::filesystem::remove(path);
+
+	// double networks are scored as double
+	using double_net = net::Net<net::BasicSimpleNet<double, 2, 5, 2>>;
+	static_assert(std::is_same_v<double_net::score_type, double>);
+	double_net d(6, 2);
+	d.seed(5).rand();
+	d.feed({1., 0.}).count_score([](const auto& res) { return res[0] - 1.; });
+	d.next();
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
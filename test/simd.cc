@@ -0,0 +1,62 @@
+#include <cassert>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <Net.hh>
+
+// check every supported kernel gives same bits as scalar kernel
+template <std::size_t IN, std::size_t OUT>
+void check_kernels() {
+	using kernel = net::LayerKernel<IN, OUT>;
+
+	constexpr std::size_t n = 5;
+
+	std::mt19937 gen{IN * 1000 + OUT};
+	std::uniform_real_distribution<net::store_type> rand(-net::mutk,
+														 net::mutk);
+
+	std::vector<net::store_type> data(kernel::stride * OUT);
+	std::vector<net::store_type> in(IN * n);
+	for (auto& v : data)
+		v = rand(gen);
+	for (auto& v : in)
+		v = rand(gen);
+
+	std::vector<net::store_type> expected(OUT * n);
+	kernel::scalar(data.data(), in.data(), n, expected.data());
+
+	for (auto s : {net::simd::sse42, net::simd::avx2, net::simd::avx512}) {
+		if (not net::simd_supported(s))
+			continue;
+
+		auto k = kernel::get(s);
+		assert(k != nullptr);
+
+		std::vector<net::store_type> out(OUT * n);
+		k(data.data(), in.data(), n, out.data());
+
+		assert(0 == std::memcmp(out.data(), expected.data(),
+								out.size() * sizeof(net::store_type)));
+	}
+}
+
+int main() {
+	assert(net::simd_supported(net::simd::scalar));
+	assert(net::simd_supported(net::simd_best()));
+
+	check_kernels<1, 1>();
+	check_kernels<2, 3>();
+	check_kernels<3, 4>();
+	check_kernels<5, 8>();
+	check_kernels<7, 16>();
+	check_kernels<16, 33>();
+	check_kernels<33, 64>();
+	check_kernels<4, 16>();
+	check_kernels<64, 24>();
+	check_kernels<12, 32>();
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -0,0 +1,46 @@
+#include <cassert>
+#include <vector>
+
+#include <Net.hh>
+
+using net_type = net::SimpleNet<3, 7, 5, 2>;
+
+int main() {
+	net_type n;
+	n.rand();
+
+	// not multiple of batch_size to check the tail block
+	constexpr std::size_t samples = net_type::batch_size * 3 + 5;
+
+	std::vector<net_type::feed_type> in(samples);
+	for (std::size_t s = 0; s < samples; ++s) {
+		for (std::size_t i = 0; i < net_type::in_size; ++i) {
+			in[s][i] = static_cast<float>(s) - static_cast<float>(i) * 0.5f;
+		}
+	}
+
+	std::vector<net_type::result_type> out(samples);
+	n.proccess_batch(in, out);
+
+	std::vector<net::store_type> raw_out(samples * net_type::out_size);
+	n.proccess_batch(in.data()->data(), samples, raw_out.data());
+
+	// batched result should be same as result of each sample
+	for (std::size_t s = 0; s < samples; ++s) {
+		auto res = n(in[s]);
+		for (std::size_t i = 0; i < net_type::out_size; ++i) {
+			assert(out[s][i] == res[i]);
+			assert(raw_out[s * net_type::out_size + i] == res[i]);
+		}
+	}
+
+	try {
+		n.proccess_batch(in, std::span(out).first(1));
+		return 1;
+	} catch (std::invalid_argument& e) {
+	}
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :
@@ -1,5 +1,6 @@
 #include <cassert>
 #include <sstream>
+#include <utility>
 
 #include <Net.hh>
 
@@ -23,6 +24,24 @@ int main() {
 
 	assert(n == n2);
 
+	// moving takes data
+	net::SimpleNet<2, 3, 5> n3{std::move(n2)};
+	assert(n3 == n);
+	n2 = n3;
+	assert(n2 == n);
+	n2.rand();
+	n3 = std::move(n2);
+	assert(not(n3 == n));
+	n2 = n;
+	assert(n2 == n);
+
+	// network over external storage copies data of moved network, which
+	// keeps its data (only moved-from networks owning data are empty)
+	net::store_type storage[net::SimpleNet<2, 3, 5>::data_size];
+	net::SimpleNet<2, 3, 5> external{storage};
+	external = std::move(n2);
+	assert(external == n && n2 == n);
+
 	return 0;
 }
 
@@ -0,0 +1,133 @@
+#include <cassert>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include <Net.hh>
+
+using net_type = net::SimpleNet<32, 70, 9, 3>;
+using sparse_type = net::SparseNet<32, 70, 9, 3>;
+
+int main() {
+	net::xoshiro256pp gen{6};
+	std::uniform_real_distribution<net::store_type> rand(-1.f, 1.f);
+
+	net_type n;
+	n.rand(gen);
+	n.mutation(200, gen);
+
+	std::vector<net_type::feed_type> samples(37);
+	for (auto& s : samples) {
+		for (auto& v : s)
+			v = rand(gen);
+	}
+
+	// without pruning results differ only by order of sums
+	sparse_type full(n, 0);
+	assert(full.nonzeros() == net_type::data_size / 2);
+	assert(full.sparsity() == 0);
+	assert(full.error(n, samples).max < 1e-5f);
+
+	// same as source network with pruned weights set to zero
+	auto threshold = sparse_type::threshold_for(n, 0.75);
+	sparse_type s(n, threshold);
+	assert(std::abs(s.sparsity() - 0.75) < 0.001);
+	{
+		auto data = n.weights();
+		std::vector<net::store_type> pruned(data.begin(), data.end());
+		for (std::size_t i = 0; i < pruned.size(); i += 2) {
+			if (std::abs(pruned[i]) < threshold)
+				pruned[i] = 0;
+		}
+		net_type p{pruned.data()};
+		assert(s.error(p, samples).max < 1e-5f);
+	}
+	auto err = s.error(n, samples);
+	assert(err.mean <= err.max && err.max > 0);
+
+	// model is several times smaller
+	assert(s.bytes() * 4 < net_type::data_size * sizeof(net::store_type));
+
+	// batch gives same results as single samples
+	std::vector<net_type::result_type> out(samples.size());
+	s.proccess_batch(samples, out);
+	for (std::size_t i = 0; i < samples.size(); ++i) {
+		auto expected = s(samples[i]);
+		for (std::size_t j = 0; j < expected.size(); ++j) {
+			assert(out[i][j] == expected[j]);
+		}
+	}
+
+	// compact form keeps results
+	{
+		std::stringstream ss;
+		ss << s;
+		assert(ss.str().size() == s.bytes());
+		sparse_type l;
+		ss >> l;
+		assert(ss);
+		assert(l.nonzeros() == s.nonzeros());
+		for (const auto& x : samples) {
+			auto a = l(x), b = s(x);
+			for (std::size_t j = 0; j < a.size(); ++j) {
+				assert(a[j] == b[j]);
+			}
+		}
+
+		// truncated and damaged data aren't loaded
+		std::string data = ss.str();
+		std::stringstream truncated(data.substr(0, data.size() - 1));
+		truncated >> l;
+		assert(not truncated);
+		data[4] = '\xff';
+		data[5] = '\xff';
+		std::stringstream damaged(data);
+		damaged >> l;
+		assert(not damaged);
+		assert(l.nonzeros() == s.nonzeros());
+	}
+
+	// activations of layers are same as of source network
+	{
+		using activated_type = net::ActivatedSimpleNet<
+			float, net::activations<net::relu, net::identity, net::hard_tanh>,
+			32, 70, 9, 3>;
+		using activated_sparse_type =
+			net::ActivatedSparseNet<activated_type::activations_type, 32, 70,
+									9, 3>;
+		activated_type a;
+		a.rand(gen);
+		a.mutation(200, gen);
+		activated_sparse_type as(a, 0);
+		assert(as.error(a, samples).max < 1e-5f);
+
+		auto t = activated_sparse_type::threshold_for(a, 0.5);
+		activated_sparse_type pruned(a, t);
+		std::vector<net::store_type> data(a.weights().begin(),
+										  a.weights().end());
+		for (std::size_t i = 0; i < data.size(); i += 2) {
+			if (std::abs(data[i]) < t)
+				data[i] = 0;
+		}
+		assert(pruned.error(activated_type{data.data()}, samples).max < 1e-5f);
+	}
+
+	// all weights pruned
+	sparse_type empty(n, sparse_type::threshold_for(n, 1));
+	assert(empty.nonzeros() == 0);
+
+	try {
+		sparse_type::threshold_for(n, 1.5);
+		return 1;
+	} catch (std::invalid_argument& e) {
+	}
+	try {
+		s.error(n, {});
+		return 1;
+	} catch (std::invalid_argument& e) {
+	}
+
+	return 0;
+}
+
+// vim: set ts=4 sw=4 :